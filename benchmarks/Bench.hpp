@@ -0,0 +1,38 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+
+// Minimal timing helper shared by the benchmark executables. Runs func_ a
+// few times and reports the best wall-clock time, which is the least noisy
+// figure on a shared build machine.
+template <typename Func_>
+double Measure(const char* name_, std::size_t ops_, Func_&& func_) {
+  constexpr int RUNS = 5;
+
+  double best_ms = 0.0;
+  for (int run = 0; run < RUNS; ++run) {
+    auto start = std::chrono::steady_clock::now();
+    func_();
+    auto stop = std::chrono::steady_clock::now();
+
+    double ms =
+        std::chrono::duration<double, std::milli>(stop - start).count();
+    if (run == 0 || ms < best_ms) {
+      best_ms = ms;
+    }
+  }
+
+  double mops =
+      best_ms > 0.0 ? static_cast<double>(ops_) / best_ms / 1e3 : 0.0;
+  std::printf("%-40s %10.3f ms  %10.2f Mops/s\n", name_, best_ms, mops);
+  return best_ms;
+}
+
+inline volatile std::size_t bench_sink = 0;
+
+// keeps the optimizer from discarding benchmark results
+inline void DoNotOptimize(std::size_t value_) {
+  bench_sink = value_;
+}
@@ -0,0 +1,69 @@
+#include <cstddef>
+#include <cstdio>
+#include <vector>
+
+#include <SECSY/ECS/Registry.hpp>
+
+#include "Bench.hpp"
+
+using SECSY::Entity;
+
+namespace {
+
+constexpr std::size_t SPAWN = 1'000'000;  // entities created per run
+
+struct Position {
+  float x, y;
+};
+
+struct Velocity {
+  float dx, dy;
+};
+
+// one Create and two Emplace calls per entity
+std::size_t SpawnEach(SECSY::Registry& registry_,
+                      const std::vector<Velocity>& velocities_) {
+  std::size_t checksum = 0;
+  for (std::size_t i = 0; i < SPAWN; ++i) {
+    Entity e = registry_.Create();
+    registry_.Emplace<Position>(e, 0.0f, 0.0f);
+    registry_.Emplace<Velocity>(e, velocities_[i]);
+    checksum += e.id;
+  }
+  return checksum;
+}
+
+// one range call per step, every pool grown once
+std::size_t SpawnBulk(SECSY::Registry& registry_,
+                      const std::vector<Velocity>& velocities_) {
+  std::vector<Entity> entities(SPAWN);
+  registry_.Create(entities.begin(), entities.end());
+  registry_.Insert(entities.begin(), entities.end(), Position{0.0f, 0.0f});
+  registry_.Insert<Velocity>(
+      entities.begin(), entities.end(), velocities_.begin());
+  return entities.back().id;
+}
+
+template <typename Func_>
+void Run(const char* name_,
+         const std::vector<Velocity>& velocities_,
+         Func_ func_) {
+  Measure(name_, SPAWN, [&] {
+    SECSY::Registry registry;
+    DoNotOptimize(func_(registry, velocities_));
+  });
+}
+
+}  // namespace
+
+int main() {
+  std::vector<Velocity> velocities(SPAWN);
+  for (std::size_t i = 0; i < SPAWN; ++i) {
+    velocities[i] = Velocity{static_cast<float>(i), 1.0f};
+  }
+
+  std::printf("bulk spawn: %zu entities with Position and Velocity\n",
+              SPAWN);
+  Run("Create + Emplace per entity", velocities, SpawnEach);
+  Run("Create(range) + Insert(range)", velocities, SpawnBulk);
+}
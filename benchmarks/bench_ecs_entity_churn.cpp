@@ -0,0 +1,89 @@
+#include <cstddef>
+#include <cstdio>
+#include <functional>
+#include <queue>
+#include <vector>
+
+#include <SECSY/Core/SparseSet.hpp>
+#include <SECSY/ECS/Registry.hpp>
+
+#include "Bench.hpp"
+
+using SECSY::Entity;
+
+namespace {
+
+constexpr std::size_t LIVE  = 100'000;    // entities alive at any time
+constexpr std::size_t CHURN = 2'000'000;  // destroy + create pairs per run
+
+// The previous recycling scheme, kept here as the baseline: live entities in
+// a SparseSet and freed handles in a min-heap.
+class QueueRecycler {
+ public:
+  Entity Create() {
+    Entity::id_type id;
+    Entity::ver_type ver;
+
+    if (m_free.empty()) {
+      id  = m_next_id++;
+      ver = 1;
+    } else {
+      Entity e = m_free.top();
+      m_free.pop();
+      id  = e.id;
+      ver = (e.ver == Entity::MAX_VERSION) ? 1 : e.ver + 1;
+    }
+
+    Entity e{id, ver};
+    m_entities.Add(e);
+    return e;
+  }
+
+  void Destroy(Entity e_) {
+    m_entities.Remove(e_);
+    m_free.push(e_);
+  }
+
+ private:
+  SECSY::SparseSet<Entity> m_entities;
+  std::priority_queue<Entity, std::vector<Entity>, std::greater<Entity>>
+      m_free;
+  Entity::id_type m_next_id{1};
+};
+
+// replaces entities in a scattered but reproducible order
+template <typename World_>
+std::size_t Churn(World_& world_, std::vector<Entity>& live_) {
+  std::size_t checksum = 0;
+  std::size_t slot     = 0;
+  for (std::size_t i = 0; i < CHURN; ++i) {
+    slot = (slot + 7919) % live_.size();
+    world_.Destroy(live_[slot]);
+    live_[slot] = world_.Create();
+    checksum += live_[slot].id;
+  }
+  return checksum;
+}
+
+template <typename World_>
+void Run(const char* name_) {
+  Measure(name_, CHURN * 2, [] {
+    World_ world;
+    std::vector<Entity> live;
+    live.reserve(LIVE);
+    for (std::size_t i = 0; i < LIVE; ++i) {
+      live.push_back(world.Create());
+    }
+    DoNotOptimize(Churn(world, live));
+  });
+}
+
+}  // namespace
+
+int main() {
+  std::printf("entity churn: %zu live, %zu destroy/create pairs\n",
+              LIVE,
+              CHURN);
+  Run<QueueRecycler>("priority_queue free list (old)");
+  Run<SECSY::Registry>("intrusive free list (Registry)");
+}
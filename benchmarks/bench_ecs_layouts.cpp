@@ -0,0 +1,93 @@
+#include <cstddef>
+#include <cstdio>
+#include <vector>
+
+#include <SECSY/ECS/ArchetypeRegistry.hpp>
+#include <SECSY/ECS/Registry.hpp>
+
+#include "Bench.hpp"
+
+using SECSY::Entity;
+
+namespace {
+
+constexpr std::size_t ENTITIES = 200'000;
+constexpr int FRAMES           = 20;
+
+struct Position {
+  float x, y;
+};
+struct Velocity {
+  float dx, dy;
+};
+struct Acceleration {
+  float ax, ay;
+};
+struct Mass {
+  float kg;
+};
+struct Drag {
+  float k;
+};
+struct Tint {
+  unsigned rgba;
+};
+
+// every entity has the five components the system reads; a third also has
+// Tint, so the sparse layout sees interleaved owners and the archetype
+// layout sees two tables
+template <typename World_>
+void Populate(World_& world_) {
+  std::vector<Entity> entities(ENTITIES);
+  world_.Create(entities.begin(), entities.end());
+  for (std::size_t i = 0; i < ENTITIES; ++i) {
+    Entity e = entities[i];
+    world_.template Emplace<Position>(e, 0.0f, 0.0f);
+    if (i % 3 == 0) {
+      world_.template Emplace<Tint>(e, 0xffffffffu);
+    }
+    world_.template Emplace<Velocity>(e, 1.0f, 0.5f);
+    world_.template Emplace<Acceleration>(e, 0.0f, -9.8f);
+    world_.template Emplace<Mass>(e, 1.0f + static_cast<float>(i % 7));
+    world_.template Emplace<Drag>(e, 0.01f);
+  }
+}
+
+template <typename World_>
+void Run(const char* name_) {
+  World_ world;
+  Populate(world);
+
+  Measure(name_, ENTITIES * FRAMES, [&] {
+    for (int f = 0; f < FRAMES; ++f) {
+      world.template View<Position, Velocity, Acceleration, Mass, Drag>()
+          .Each([](Entity,
+                   Position& pos,
+                   Velocity& vel,
+                   Acceleration& acc,
+                   Mass& mass,
+                   Drag& drag) {
+            float inv = 1.0f / mass.kg;
+            vel.dx += (acc.ax - drag.k * vel.dx) * inv * 0.016f;
+            vel.dy += (acc.ay - drag.k * vel.dy) * inv * 0.016f;
+            pos.x += vel.dx * 0.016f;
+            pos.y += vel.dy * 0.016f;
+          });
+    }
+
+    double sum = 0.0;
+    world.template View<Position>().Each(
+        [&](Entity, const Position& pos) { sum += pos.x; });
+    DoNotOptimize(static_cast<std::size_t>(sum));
+  });
+}
+
+}  // namespace
+
+int main() {
+  std::printf("5-component system: %zu entities, %d frames\n",
+              ENTITIES,
+              FRAMES);
+  Run<SECSY::Registry>("sparse-set Registry");
+  Run<SECSY::ArchetypeRegistry>("ArchetypeRegistry");
+}
@@ -0,0 +1,68 @@
+#include <cstddef>
+#include <cstdio>
+#include <memory_resource>
+#include <vector>
+
+#include <SECSY/Core/Arena.hpp>
+#include <SECSY/ECS/Registry.hpp>
+
+#include "Bench.hpp"
+
+using SECSY::Entity;
+
+namespace {
+
+constexpr std::size_t ENTITIES = 200'000;  // entities per level
+constexpr std::size_t LEVELS   = 10;       // loads per run
+
+struct Position {
+  float x, y;
+};
+
+struct Velocity {
+  float dx, dy;
+};
+
+struct Health {
+  int hp;
+};
+
+// builds a level entity by entity, like a level loader would
+std::size_t LoadLevel(SECSY::Registry& registry_) {
+  std::size_t checksum = 0;
+  for (std::size_t i = 0; i < ENTITIES; ++i) {
+    Entity e = registry_.Create();
+    registry_.Emplace<Position>(e, 0.0f, 0.0f);
+    if (i % 2 == 0) {
+      registry_.Emplace<Velocity>(e, 1.0f, 1.0f);
+    }
+    if (i % 5 == 0) {
+      registry_.Emplace<Health>(e, 100);
+    }
+    checksum += e.id;
+  }
+  return checksum;
+}
+
+}  // namespace
+
+int main() {
+  std::printf("level reload: %zu levels of %zu entities\n", LEVELS, ENTITIES);
+
+  Measure("global heap, fresh Registry", LEVELS * ENTITIES, [] {
+    for (std::size_t level = 0; level < LEVELS; ++level) {
+      SECSY::Registry registry;
+      DoNotOptimize(LoadLevel(registry));
+    }
+  });
+
+  Measure("Arena, Clear + Release", LEVELS * ENTITIES, [] {
+    SECSY::Arena arena;
+    SECSY::Registry registry(arena.Resource());
+    for (std::size_t level = 0; level < LEVELS; ++level) {
+      DoNotOptimize(LoadLevel(registry));
+      registry.Clear();
+      arena.Release();
+    }
+  });
+}
@@ -0,0 +1,74 @@
+#include <cmath>
+#include <cstddef>
+#include <cstdio>
+#include <vector>
+
+#include <SECSY/Core/JobSystem.hpp>
+#include <SECSY/ECS/Registry.hpp>
+
+#include "Bench.hpp"
+
+using SECSY::Entity;
+
+namespace {
+
+constexpr std::size_t ENTITIES = 1'000'000;
+constexpr int FRAMES           = 10;  // view passes per run
+
+struct Position {
+  float x, y;
+};
+
+struct Velocity {
+  float dx, dy;
+};
+
+// enough arithmetic per entity to resemble a small movement system
+void Integrate(Entity, Position& pos_, Velocity& vel_) {
+  vel_.dx = vel_.dx * 0.99f + std::sin(pos_.y) * 0.01f;
+  vel_.dy = vel_.dy * 0.99f + std::cos(pos_.x) * 0.01f;
+  pos_.x += vel_.dx;
+  pos_.y += vel_.dy;
+}
+
+std::size_t Checksum(SECSY::Registry& registry_) {
+  double sum = 0.0;
+  registry_.View<Position>().Each(
+      [&](Entity, const Position& pos) { sum += pos.x + pos.y; });
+  return static_cast<std::size_t>(std::abs(sum));
+}
+
+}  // namespace
+
+int main() {
+  SECSY::Registry registry;
+  std::vector<Entity> entities(ENTITIES);
+  registry.Create(entities.begin(), entities.end());
+  registry.Insert(entities.begin(), entities.end(), Position{1.0f, 2.0f});
+  // every other entity moves, so the view has to skip non-matches
+  for (std::size_t i = 0; i < ENTITIES; i += 2) {
+    registry.Emplace<Velocity>(entities[i], 0.5f, -0.5f);
+  }
+
+  SECSY::JobSystem jobs;
+  std::printf("view iteration: %zu entities, %d frames, %zu workers + caller\n",
+              ENTITIES,
+              FRAMES,
+              jobs.WorkerCount());
+
+  Measure("serial range-for", ENTITIES * FRAMES, [&] {
+    for (int f = 0; f < FRAMES; ++f) {
+      for (auto&& [e, pos, vel] : registry.View<Position, Velocity>()) {
+        Integrate(e, pos, vel);
+      }
+    }
+    DoNotOptimize(Checksum(registry));
+  });
+
+  Measure("ParallelEach", ENTITIES * FRAMES, [&] {
+    for (int f = 0; f < FRAMES; ++f) {
+      registry.View<Position, Velocity>().ParallelEach(jobs, Integrate);
+    }
+    DoNotOptimize(Checksum(registry));
+  });
+}
@@ -0,0 +1,132 @@
+#include <cstddef>
+#include <cstdio>
+#include <sstream>
+#include <vector>
+
+#include <SECSY/ECS/Delta.hpp>
+#include <SECSY/ECS/Registry.hpp>
+#include <SECSY/ECS/Snapshot.hpp>
+
+#include "Bench.hpp"
+
+using SECSY::Entity;
+
+namespace {
+
+constexpr std::size_t ENTITIES = 200'000;  // world size
+constexpr std::size_t TOUCHED  = 500;      // components changed per frame
+constexpr std::size_t SPAWNED  = 20;       // entities created per frame
+constexpr std::size_t FRAMES   = 60;
+
+struct Position {
+  float x, y;
+};
+
+struct Velocity {
+  float dx, dy;
+};
+
+struct Boss {};  // a handful of entities
+
+constexpr std::size_t BOSSES = 10;
+
+using WorldSnapshot = SECSY::Snapshot<Position, Velocity, Boss>;
+
+// a frame of gameplay touching a small part of the world
+void Simulate(SECSY::Registry& registry_,
+              const std::vector<Entity>& entities_,
+              std::size_t frame_) {
+  for (std::size_t i = 0; i < TOUCHED; ++i) {
+    Entity e = entities_[(frame_ * TOUCHED + i * 397) % entities_.size()];
+    registry_.Get<Position>(e).x += 1.0f;
+  }
+  for (std::size_t i = 0; i < SPAWNED; ++i) {
+    Entity e = registry_.Create();
+    registry_.Emplace<Position>(e, 0.0f, 0.0f);
+    registry_.Emplace<Velocity>(e, 1.0f, 1.0f);
+  }
+}
+
+// a frame run by systems: a sparse view writing to the few bosses, then
+// one read-only pass over everything
+void SimulateViews(SECSY::Registry& registry_) {
+  registry_.View<Position, const Boss>().Each(
+      [](Entity, Position& pos_, const Boss&) { pos_.y += 1.0f; });
+  float sum = 0.0f;
+  registry_.View<const Position, const Velocity>().Each(
+      [&](Entity, const Position& pos_, const Velocity& vel_) {
+        sum += pos_.x * vel_.dx;
+      });
+  DoNotOptimize(sum);
+}
+
+}  // namespace
+
+int main() {
+  SECSY::Registry registry;
+  std::vector<Entity> entities(ENTITIES);
+  registry.Create(entities.begin(), entities.end());
+  registry.Insert(entities.begin(), entities.end(), Position{0.0f, 0.0f});
+  registry.Insert(entities.begin(), entities.end(), Velocity{1.0f, 1.0f});
+  for (std::size_t i = 0; i < BOSSES; ++i) {
+    registry.Emplace<Boss>(entities[i * (ENTITIES / BOSSES)]);
+  }
+
+  std::printf("rollback: %zu entities, %zu changes + %zu spawns per frame, "
+              "%zu frames\n",
+              ENTITIES,
+              TOUCHED,
+              SPAWNED,
+              FRAMES);
+
+  Measure("full snapshot per frame, load back", FRAMES, [&] {
+    std::ostringstream start(std::ios::binary);
+    WorldSnapshot::Save(registry, start);
+    for (std::size_t frame = 0; frame < FRAMES; ++frame) {
+      std::ostringstream out(std::ios::binary);
+      WorldSnapshot::Save(registry, out);
+      Simulate(registry, entities, frame);
+      DoNotOptimize(static_cast<std::size_t>(out.tellp()));
+    }
+    const std::string data = std::move(start).str();
+    WorldSnapshot::Load(registry,
+                        std::as_bytes(std::span(data.data(), data.size())));
+  });
+
+  std::vector<SECSY::Delta> deltas(FRAMES);
+  Measure("delta per frame, roll back", FRAMES, [&] {
+    for (std::size_t frame = 0; frame < FRAMES; ++frame) {
+      registry.Record(deltas[frame]);
+      Simulate(registry, entities, frame);
+    }
+    for (std::size_t frame = FRAMES; frame-- > 0;) {
+      registry.Rollback(deltas[frame]);
+    }
+  });
+
+  Measure("simulation alone, not recording", FRAMES, [&] {
+    for (std::size_t frame = 0; frame < FRAMES; ++frame) {
+      Simulate(registry, entities, frame);
+    }
+  });
+
+  // views log only the components they hand out mutably
+  std::size_t logged = 0;
+  Measure("view frame, delta per frame, roll back", FRAMES, [&] {
+    for (std::size_t frame = 0; frame < FRAMES; ++frame) {
+      registry.Record(deltas[frame]);
+      SimulateViews(registry);
+      logged = deltas[frame].Size();
+    }
+    for (std::size_t frame = FRAMES; frame-- > 0;) {
+      registry.Rollback(deltas[frame]);
+    }
+  });
+  std::printf("  %zu entries per view frame\n", logged);
+
+  Measure("view frame alone, not recording", FRAMES, [&] {
+    for (std::size_t frame = 0; frame < FRAMES; ++frame) {
+      SimulateViews(registry);
+    }
+  });
+}
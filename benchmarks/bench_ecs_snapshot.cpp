@@ -0,0 +1,71 @@
+#include <cstddef>
+#include <cstdio>
+#include <span>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <SECSY/ECS/Registry.hpp>
+#include <SECSY/ECS/Snapshot.hpp>
+
+#include "Bench.hpp"
+
+using SECSY::Entity;
+
+namespace {
+
+constexpr std::size_t ENTITIES = 1'000'000;
+
+struct Position {
+  float x, y;
+};
+
+struct Velocity {
+  float dx, dy;
+};
+
+using WorldSnapshot = SECSY::Snapshot<Position, Velocity>;
+
+}  // namespace
+
+int main() {
+  SECSY::Registry source;
+  std::vector<Entity> entities(ENTITIES);
+  source.Create(entities.begin(), entities.end());
+  for (std::size_t i = 0; i < ENTITIES; ++i) {
+    source.Emplace<Position>(entities[i], static_cast<float>(i), 0.0f);
+    source.Emplace<Velocity>(entities[i], 1.0f, 1.0f);
+  }
+
+  std::ostringstream out(std::ios::binary);
+  WorldSnapshot::Save(source, out);
+  const std::string data = std::move(out).str();
+  const auto bytes       = std::as_bytes(std::span(data.data(), data.size()));
+
+  std::printf("world load: %zu entities with Position and Velocity, "
+              "%zu byte snapshot\n",
+              ENTITIES,
+              data.size());
+
+  Measure("Create + Emplace per entity", ENTITIES, [&] {
+    SECSY::Registry registry;
+    for (std::size_t i = 0; i < ENTITIES; ++i) {
+      Entity e = registry.Create();
+      registry.Emplace<Position>(e, static_cast<float>(i), 0.0f);
+      registry.Emplace<Velocity>(e, 1.0f, 1.0f);
+    }
+    DoNotOptimize(registry.Get<Position>(entities.back()).x > 0.0f);
+  });
+
+  Measure("Snapshot::Load from memory", ENTITIES, [&] {
+    SECSY::Registry registry;
+    WorldSnapshot::Load(registry, bytes);
+    DoNotOptimize(registry.Get<Position>(entities.back()).x > 0.0f);
+  });
+
+  Measure("Snapshot::Save to memory", ENTITIES, [&] {
+    std::ostringstream sink(std::ios::binary);
+    WorldSnapshot::Save(source, sink);
+    DoNotOptimize(static_cast<std::size_t>(sink.tellp()));
+  });
+}
@@ -0,0 +1,83 @@
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+#include <SECSY/ECS/Registry.hpp>
+
+#include "Bench.hpp"
+
+using SECSY::Entity;
+
+namespace {
+
+constexpr std::size_t ENTITIES = 500'000;
+constexpr int FRAMES           = 20;
+
+struct Transform {
+  float x, y, rotation, scale;
+  float matrix[12];
+};
+
+struct Sprite {
+  std::uint32_t texture;
+  std::int32_t layer;
+  float u, v;
+};
+
+// Transforms are added in one order and Sprites in a scattered one, as
+// after a level's worth of churn, so the two pools disagree on order
+void Populate(SECSY::Registry& registry_) {
+  std::vector<Entity> entities(ENTITIES);
+  registry_.Create(entities.begin(), entities.end());
+  for (Entity e : entities) {
+    registry_.Emplace<Transform>(e, Transform{1.0f, 2.0f, 0.0f, 1.0f, {}});
+  }
+
+  std::size_t slot = 0;
+  for (std::size_t i = 0; i < ENTITIES; ++i) {
+    slot = (slot + 7919) % ENTITIES;
+    registry_.Emplace<Sprite>(entities[slot],
+                              static_cast<std::uint32_t>(slot % 64),
+                              static_cast<std::int32_t>(slot % 8),
+                              0.0f,
+                              0.0f);
+  }
+}
+
+// a render-like pass: Sprite drives, Transform is probed
+std::size_t Draw(SECSY::Registry& registry_) {
+  std::size_t checksum = 0;
+  for (int f = 0; f < FRAMES; ++f) {
+    registry_.View<const Sprite, const Transform>().Each(
+        [&](Entity, const Sprite& sprite, const Transform& transform) {
+          checksum += sprite.texture +
+                      static_cast<std::size_t>(transform.x + transform.scale);
+        });
+  }
+  return checksum;
+}
+
+}  // namespace
+
+int main() {
+  std::printf("View<Sprite, Transform>: %zu entities, %d frames\n",
+              ENTITIES,
+              FRAMES);
+
+  SECSY::Registry registry;
+  Populate(registry);
+
+  Measure("pools in unrelated order", ENTITIES * FRAMES, [&] {
+    DoNotOptimize(Draw(registry));
+  });
+
+  Measure("Sort<Sprite> by layer + SortAs<Transform>", ENTITIES, [&] {
+    registry.Sort<Sprite, &Sprite::layer>();
+    registry.SortAs<Transform, Sprite>();
+  });
+
+  Measure("pools in matching order", ENTITIES * FRAMES, [&] {
+    DoNotOptimize(Draw(registry));
+  });
+}
@@ -0,0 +1,143 @@
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <numeric>
+#include <optional>
+#include <vector>
+
+#include <SECSY/Core/SkylinePacker.hpp>
+#include <SECSY/Render/HeadlessBackend.hpp>
+#include <SECSY/Render/Renderer.hpp>
+
+#include "Bench.hpp"
+
+namespace {
+
+constexpr std::size_t SPRITES  = 50'000;
+constexpr std::size_t IMAGES   = 1024;
+constexpr int FRAMES           = 60;
+constexpr int LAYERS           = 4;
+constexpr std::int32_t PAGE    = 2048;
+constexpr std::int32_t PADDING = 1;
+
+using HeadlessRenderer = SECSY::BasicRenderer<SECSY::HeadlessBackend>;
+
+struct ImageSize {
+  std::int32_t width, height;
+};
+
+// Packs images the way TextureAtlas does, tallest first into the first
+// page with room, but only the rectangles: no GPU is needed. Returns the
+// texture and source each image ends up drawn from.
+std::vector<SpriteDrawCommand> Pack(const std::vector<ImageSize>& images_,
+                                    std::size_t& pages_) {
+  std::vector<std::size_t> order(images_.size());
+  std::iota(order.begin(), order.end(), std::size_t{0});
+  std::stable_sort(order.begin(), order.end(), [&](auto lhs_, auto rhs_) {
+    return images_[lhs_].height > images_[rhs_].height;
+  });
+
+  std::vector<SECSY::SkylinePacker> packers;
+  std::vector<SpriteDrawCommand> regions(images_.size());
+  for (std::size_t index : order) {
+    std::int32_t w = images_[index].width + 2 * PADDING;
+    std::int32_t h = images_[index].height + 2 * PADDING;
+
+    std::size_t page = 0;
+    std::optional<SECSY::SkylinePacker::Rect> spot;
+    while (page < packers.size() && !(spot = packers[page].Insert(w, h))) {
+      ++page;
+    }
+    if (!spot) {
+      packers.emplace_back(PAGE, PAGE);
+      spot = packers.back().Insert(w, h);
+    }
+
+    auto& region   = regions[index];
+    auto id        = static_cast<unsigned>(page) + 1;
+    region.texture = Texture2D{id, PAGE, PAGE, 1, 0};
+    region.source  = {static_cast<float>(spot->x + PADDING),
+                      static_cast<float>(spot->y + PADDING),
+                      static_cast<float>(images_[index].width),
+                      static_cast<float>(images_[index].height)};
+  }
+  pages_ = packers.size();
+  return regions;
+}
+
+void Run(const char* name_,
+         const std::vector<SpriteDrawCommand>& sprites_,
+         HeadlessRenderer& renderer_) {
+  Measure(name_, SPRITES * FRAMES, [&] {
+    for (int f = 0; f < FRAMES; ++f) {
+      renderer_.Begin();
+      for (const auto& cmd : sprites_) {
+        renderer_.Submit(cmd);
+      }
+      renderer_.End();
+    }
+    DoNotOptimize(renderer_.Backend().Quads().size());
+  });
+  std::printf("  per frame: %zu batches, %zu texture switches\n",
+              renderer_.Stats().batches,
+              renderer_.Stats().texture_switches);
+}
+
+}  // namespace
+
+// The same scene drawn from one texture per image and from atlas pages:
+// what changes is the number of texture runs the renderer hands the
+// backend, and the cost of handing them over
+int main() {
+  std::vector<ImageSize> images(IMAGES);
+  std::uint32_t state = 1;
+  for (auto& image : images) {
+    state        = state * 1664525u + 1013904223u;
+    image.width  = 16 + static_cast<std::int32_t>((state >> 8) % 113);
+    image.height = 16 + static_cast<std::int32_t>((state >> 20) % 113);
+  }
+
+  std::size_t pages = 0;
+  auto packed       = Pack(images, pages);
+
+  std::vector<SpriteDrawCommand> separate(SPRITES);
+  std::vector<SpriteDrawCommand> atlased(SPRITES);
+  for (std::size_t i = 0; i < SPRITES; ++i) {
+    std::size_t image = (i * 2654435761u) % IMAGES;
+
+    auto& cmd    = separate[i];
+    cmd.texture  = Texture2D{static_cast<unsigned>(image) + 1,
+                            images[image].width,
+                            images[image].height,
+                            1,
+                            0};
+    cmd.source   = {0,
+                    0,
+                    static_cast<float>(images[image].width),
+                    static_cast<float>(images[image].height)};
+    cmd.position = {static_cast<float>(i % 1280), static_cast<float>(i % 720)};
+    cmd.scale    = {1.0f, 1.0f};
+    cmd.tint     = {255, 255, 255, 255};
+    cmd.layer    = static_cast<int>((i / 97) % LAYERS);
+
+    atlased[i]         = cmd;
+    atlased[i].texture = packed[image].texture;
+    atlased[i].source  = packed[image].source;
+  }
+
+  std::printf("atlas: %zu sprites, %zu images packed into %zu %dx%d pages, "
+              "%d layers, %d frames\n",
+              SPRITES,
+              IMAGES,
+              pages,
+              PAGE,
+              PAGE,
+              LAYERS,
+              FRAMES);
+
+  HeadlessRenderer renderer(1280, 720);
+  renderer.Reserve(SPRITES);
+  Run("one texture per image", separate, renderer);
+  Run("atlas pages", atlased, renderer);
+}
@@ -0,0 +1,138 @@
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+#include <SECSY/ECS/Registry.hpp>
+#include <SECSY/Render/HeadlessBackend.hpp>
+#include <SECSY/Render/Renderer.hpp>
+#include <SECSY/Render/System.hpp>
+#include <SECSY/Render/TextureCache.hpp>
+
+#include "Bench.hpp"
+
+namespace {
+
+constexpr std::uint32_t WIDTH   = 1280;
+constexpr std::uint32_t HEIGHT  = 720;
+constexpr std::size_t ON_SCREEN = 5'000;  // sprites per screen of world
+constexpr int FRAMES            = 60;
+constexpr std::size_t MOVERS    = 100;  // sprites moved each frame
+
+using HeadlessRenderer = SECSY::BasicRenderer<SECSY::HeadlessBackend>;
+
+// every path is a 32x32 texture, no GPU involved
+struct BenchLoader {
+  Texture2D Load(const char*) {
+    return Texture2D{1, 32, 32, 1, 0};
+  }
+
+  void Unload(Texture2D) {}
+};
+
+using BenchCache = SECSY::BasicTextureCache<BenchLoader>;
+
+// a world of screens_ x screens_ screens at constant density
+std::vector<SECSY::Entity> Populate(SECSY::Registry& reg_,
+                                    SECSY::TextureHandle texture_,
+                                    int screens_) {
+  std::size_t count = ON_SCREEN * screens_ * screens_;
+  float width       = static_cast<float>(WIDTH) * screens_;
+  float height      = static_cast<float>(HEIGHT) * screens_;
+
+  std::vector<SECSY::Entity> entities(count);
+  reg_.Create(entities.begin(), entities.end());
+  for (std::size_t i = 0; i < count; ++i) {
+    // rows top to bottom, hashed across, so density stays even
+    float u = static_cast<float>((i * 2654435761u) % 65536) / 65536.0f;
+    float v = static_cast<float>(i) / static_cast<float>(count);
+    reg_.Emplace<SECSY::Transform>(
+        entities[i], Vector2{u * width, v * height}, 0.0f, Vector2{1, 1});
+    reg_.Emplace<SECSY::Sprite>(entities[i],
+                                texture_,
+                                Rectangle{0, 0, 32, 32},
+                                Color{255, 255, 255, 255},
+                                static_cast<int>(i % 4));
+  }
+  return entities;
+}
+
+// moves a few sprites, as gameplay would, and pans the camera
+void Step(SECSY::Registry& reg_,
+          const std::vector<SECSY::Entity>& entities_,
+          HeadlessRenderer& renderer_,
+          int frame_) {
+  for (std::size_t i = 0; i < MOVERS; ++i) {
+    auto e = entities_[(frame_ * 7919 + i * 104729) % entities_.size()];
+    reg_.Get<SECSY::Transform>(e).position.x += 3.0f;
+  }
+  renderer_.SetCamera(
+      SECSY::RenderCamera{{static_cast<float>(frame_ * 4), 0.0f}, 1.0f});
+}
+
+}  // namespace
+
+// Frames of a panning camera over worlds of growing size at the same
+// on-screen density. Testing every sprite grows with the world; through the
+// grid, culling and drawing follow what is on screen and Sync follows the
+// sprites moved, read from the pools' lists of slots changed this tick.
+int main() {
+  std::printf("culling: %zu sprites per screen, %zu moved per frame, "
+              "%d frames\n",
+              ON_SCREEN,
+              MOVERS,
+              FRAMES);
+
+  BenchCache textures;
+  auto texture = textures.Load("sprite.png");
+
+  for (int screens : {1, 4, 8}) {
+    SECSY::Registry reg;
+    auto entities = Populate(reg, texture, screens);
+    std::printf("\nworld of %dx%d screens, %zu sprites\n",
+                screens,
+                screens,
+                entities.size());
+
+    HeadlessRenderer renderer(WIDTH, HEIGHT);
+    SECSY::RenderSystem system(reg, 128);
+    system.Sync();
+    std::size_t drawn = 0;
+    Measure("RenderSystem (grid)", FRAMES, [&] {
+      for (int f = 0; f < FRAMES; ++f) {
+        Step(reg, entities, renderer, f);
+        renderer.Begin();
+        system.Run(renderer, textures);
+        renderer.End();
+        drawn = renderer.Stats().sprites;
+      }
+    });
+    std::printf("  %zu sprites drawn in the last frame\n", drawn);
+
+    Measure("test every sprite", FRAMES, [&] {
+      for (int f = 0; f < FRAMES; ++f) {
+        Step(reg, entities, renderer, f);
+        Rectangle view = renderer.Viewport();
+        renderer.Begin();
+        reg.View<const SECSY::Transform, const SECSY::Sprite>().Each(
+            [&](SECSY::Entity,
+                const SECSY::Transform& tf_,
+                const SECSY::Sprite& sprite_) {
+              Rectangle b = SECSY::RenderSystem::Bounds(tf_, sprite_);
+              if (b.x < view.x + view.width && view.x < b.x + b.width &&
+                  b.y < view.y + view.height && view.y < b.y + b.height) {
+                renderer.Submit(SpriteDrawCommand{textures.Get(sprite_.texture),
+                                                  sprite_.source,
+                                                  tf_.position,
+                                                  tf_.rotation,
+                                                  tf_.scale,
+                                                  sprite_.tint,
+                                                  sprite_.layer});
+              }
+            });
+        renderer.End();
+      }
+      DoNotOptimize(renderer.Stats().sprites);
+    });
+  }
+}
@@ -0,0 +1,62 @@
+#include <cstddef>
+#include <cstdio>
+#include <vector>
+
+#include <SECSY/Render/HeadlessBackend.hpp>
+#include <SECSY/Render/Renderer.hpp>
+
+#include "Bench.hpp"
+
+namespace {
+
+constexpr std::size_t SPRITES = 50'000;
+constexpr int FRAMES          = 60;
+constexpr int LAYERS          = 8;
+constexpr unsigned TEXTURES   = 64;
+
+using HeadlessRenderer = SECSY::BasicRenderer<SECSY::HeadlessBackend>;
+
+}  // namespace
+
+// Whole frames through the draw pipeline, minus the GPU: submission, the
+// sort, quad generation and batching, recorded by the headless backend
+int main() {
+  std::vector<SpriteDrawCommand> sprites(SPRITES);
+  for (std::size_t i = 0; i < SPRITES; ++i) {
+    auto& cmd    = sprites[i];
+    auto texture = static_cast<unsigned>((i * 2654435761u) % TEXTURES) + 1;
+    cmd.texture  = Texture2D{texture, 32, 32, 1, 0};
+    cmd.source   = {0, 0, 32, 32};
+    cmd.position = {static_cast<float>(i % 1280), static_cast<float>(i % 720)};
+    cmd.rotation = (i % 4 == 0) ? 15.0f : 0.0f;
+    cmd.scale    = {1.0f, 1.0f};
+    cmd.tint     = {255, 255, 255, 255};
+    cmd.layer    = static_cast<int>((i / 97) % LAYERS);
+  }
+
+  std::printf("headless frames: %zu sprites, %d layers, %u textures, "
+              "%d frames\n",
+              SPRITES,
+              LAYERS,
+              TEXTURES,
+              FRAMES);
+
+  HeadlessRenderer renderer(1280, 720);
+  renderer.Reserve(SPRITES);
+  Measure("Submit + End per frame", SPRITES * FRAMES, [&] {
+    for (int f = 0; f < FRAMES; ++f) {
+      renderer.Begin();
+      for (const auto& cmd : sprites) {
+        renderer.Submit(cmd);
+      }
+      renderer.End();
+    }
+    DoNotOptimize(renderer.Backend().Quads().size());
+  });
+
+  const auto& stats = renderer.Stats();
+  std::printf("per frame: %zu sprites, %zu batches, %zu texture switches\n",
+              stats.sprites,
+              stats.batches,
+              stats.texture_switches);
+}
@@ -0,0 +1,110 @@
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <deque>
+#include <vector>
+
+#include <SECSY/Core/RadixSort.hpp>
+
+#include "Bench.hpp"
+
+namespace {
+
+constexpr std::size_t SPRITES = 50'000;
+constexpr int FRAMES          = 60;
+constexpr int LAYERS          = 8;
+constexpr unsigned TEXTURES   = 64;
+
+// the old draw command, minus raylib: Texture2D, position, rotation,
+// scale, tint and layer
+struct OldCommand {
+  unsigned int texture;
+  int width, height, mipmaps, format;
+  float x, y, rotation, scale_x, scale_y;
+  std::uint8_t tint[4];
+  int layer;
+};
+
+OldCommand MakeCommand(std::size_t i_) {
+  OldCommand cmd{};
+  cmd.texture = static_cast<unsigned>((i_ * 2654435761u) % TEXTURES) + 1;
+  cmd.layer   = static_cast<int>((i_ / 97) % LAYERS);
+  cmd.x       = static_cast<float>(i_ % 1280);
+  cmd.y       = static_cast<float>(i_ % 720);
+  return cmd;
+}
+
+// consecutive sprites with different textures: one rlgl draw each
+template <typename Texture_>
+std::size_t Runs(std::size_t count_, Texture_&& texture_) {
+  std::size_t runs = 0;
+  for (std::size_t i = 0; i < count_; ++i) {
+    runs += i == 0 || texture_(i) != texture_(i - 1);
+  }
+  return runs;
+}
+
+}  // namespace
+
+int main() {
+  std::printf("draw queue: %zu sprites, %d layers, %u textures, %d frames\n",
+              SPRITES,
+              LAYERS,
+              TEXTURES,
+              FRAMES);
+
+  std::deque<OldCommand> old_queue;
+  Measure("deque + std::sort by layer", SPRITES * FRAMES, [&] {
+    for (int f = 0; f < FRAMES; ++f) {
+      old_queue.clear();
+      for (std::size_t i = 0; i < SPRITES; ++i) {
+        old_queue.push_back(MakeCommand(i));
+      }
+      std::sort(old_queue.begin(),
+                old_queue.end(),
+                [](const auto& a, const auto& b) { return a.layer < b.layer; });
+      DoNotOptimize(old_queue.back().texture);
+    }
+  });
+  std::size_t old_runs = Runs(
+      old_queue.size(), [&](std::size_t i) { return old_queue[i].texture; });
+
+  struct Packed {
+    float x, y, width, height, rotation;
+    std::uint8_t tint[4];
+    unsigned int texture;
+  };
+  std::vector<Packed> queue;
+  std::vector<std::uint64_t> keys;
+  std::vector<std::uint32_t> order;
+  SECSY::RadixSorter sorter;
+  Measure("vector + radix sort by layer, texture", SPRITES * FRAMES, [&] {
+    for (int f = 0; f < FRAMES; ++f) {
+      queue.clear();
+      keys.clear();
+      order.clear();
+      for (std::size_t i = 0; i < SPRITES; ++i) {
+        OldCommand cmd = MakeCommand(i);
+        auto layer     = static_cast<std::uint32_t>(cmd.layer) ^ 0x80000000u;
+        keys.push_back((std::uint64_t{layer} << 32) | cmd.texture);
+        order.push_back(static_cast<std::uint32_t>(queue.size()));
+        queue.push_back(Packed{cmd.x,
+                               cmd.y,
+                               1.0f,
+                               1.0f,
+                               cmd.rotation,
+                               {},
+                               cmd.texture});
+      }
+      sorter.Sort(keys, order);
+      DoNotOptimize(queue[order.back()].texture);
+    }
+  });
+  std::size_t new_runs = Runs(
+      order.size(), [&](std::size_t i) { return queue[order[i]].texture; });
+
+  std::printf("texture runs per frame: %zu by layer, %zu by layer + texture\n",
+              old_runs,
+              new_runs);
+}
@@ -0,0 +1,129 @@
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <type_traits>
+#include <vector>
+
+#include <SECSY/ECS/Registry.hpp>
+#include <SECSY/Render/Components.hpp>
+
+#include "Bench.hpp"
+
+using SECSY::Entity;
+
+namespace {
+
+constexpr std::size_t SPRITES = 200'000;
+constexpr int ROUNDS          = 10;
+
+// how raylib::Texture behaves: owns the GPU texture, so moving it clears
+// the source and destroying it unloads whatever it still holds
+class OwnedTexture {
+ public:
+  explicit OwnedTexture(unsigned int id_) : m_texture{id_, 32, 32, 1, 7} {}
+
+  OwnedTexture(OwnedTexture&& other_) noexcept : m_texture(other_.m_texture) {
+    other_.m_texture.id = 0;
+  }
+
+  OwnedTexture& operator=(OwnedTexture&& other_) noexcept {
+    Unload();
+    m_texture           = other_.m_texture;
+    other_.m_texture.id = 0;
+    return *this;
+  }
+
+  ~OwnedTexture() {
+    Unload();
+  }
+
+ private:
+  void Unload() noexcept {
+    if (m_texture.id != 0) {
+      bench_sink = m_texture.id;  // UnloadTexture would go here
+    }
+  }
+
+  Texture2D m_texture;
+};
+
+// the Sprite layout before texture handles
+struct OwningSprite {
+  OwnedTexture texture;
+  Rectangle source;
+  Color tint;
+  std::int32_t layer;
+};
+
+template <typename Sprite_>
+Sprite_ Make(std::size_t i_) {
+  auto texture = static_cast<unsigned int>(i_ % 64) + 1;
+  auto layer   = static_cast<std::int32_t>((i_ * 2654435761u) % 16);
+  if constexpr (std::is_same_v<Sprite_, SECSY::Sprite>) {
+    return Sprite_{SECSY::TextureHandle{texture},
+                   Rectangle{0, 0, 32, 32},
+                   Color{255, 255, 255, 255},
+                   layer};
+  } else {
+    return Sprite_{OwnedTexture(texture),
+                   Rectangle{0, 0, 32, 32},
+                   Color{255, 255, 255, 255},
+                   layer};
+  }
+}
+
+// Per round a third of the sprites are removed and added back, which
+// relocates pool entries by swap-and-pop, then the pool is sorted by layer
+// for drawing. The churn is timed alone, then followed by the sort.
+template <typename Sprite_>
+void Run(const char* name_) {
+  SECSY::Registry registry;
+  std::vector<Entity> entities(SPRITES);
+  registry.Create(entities.begin(), entities.end());
+  for (std::size_t i = 0; i < SPRITES; ++i) {
+    registry.Emplace<Sprite_>(entities[i], Make<Sprite_>(i));
+  }
+
+  auto churn = [&](int round_) {
+    for (std::size_t i = round_ % 3; i < SPRITES; i += 3) {
+      registry.Remove<Sprite_>(entities[i]);
+    }
+    for (std::size_t i = round_ % 3; i < SPRITES; i += 3) {
+      registry.Emplace<Sprite_>(entities[i], Make<Sprite_>(i + round_));
+    }
+  };
+  auto sort = [&] {
+    registry.Sort<Sprite_>([](const Sprite_& lhs_, const Sprite_& rhs_) {
+      return lhs_.layer < rhs_.layer;
+    });
+  };
+
+  std::printf("%s\n", name_);
+  Measure("  remove + re-add a third", SPRITES * ROUNDS, [&] {
+    for (int round = 0; round < ROUNDS; ++round) {
+      churn(round);
+    }
+  });
+  Measure("  same, then sort by layer", SPRITES * ROUNDS, [&] {
+    for (int round = 0; round < ROUNDS; ++round) {
+      churn(round);
+      sort();
+    }
+  });
+}
+
+}  // namespace
+
+// Sprite churn and sorting with texture handles against the old owning
+// layout; the handle version is trivially copyable and a third smaller
+int main() {
+  std::printf("sprite pool: %zu sprites, %d rounds; sizeof(Sprite) = %zu, "
+              "owning layout = %zu\n",
+              SPRITES,
+              ROUNDS,
+              sizeof(SECSY::Sprite),
+              sizeof(OwningSprite));
+
+  Run<OwningSprite>("owning texture");
+  Run<SECSY::Sprite>("texture handle");
+}
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <cstddef>
+#include <memory_resource>
+
+namespace SECSY {
+
+// Memory resource for level-lifetime worlds. Large blocks are carved
+// monotonically out of a few big upstream allocations; small and mid-sized
+// blocks (sparse pages, bookkeeping arrays) go through size-class pools on
+// top of that, so memory freed while the level runs is reused. Release hands
+// everything back at once, at a cost that depends on the number of upstream
+// blocks, not on how many objects were allocated.
+class Arena {
+ public:
+  using size_type = std::size_t;
+
+  static constexpr size_type DEFAULT_BLOCK = size_type{1} << 20;
+
+  // largest request served from a pool, sized to fit a sparse page
+  static constexpr size_type LARGEST_POOLED = size_type{1} << 16;
+
+  explicit Arena(size_type initial_block_           = DEFAULT_BLOCK,
+                 std::pmr::memory_resource* upstream_ =
+                     std::pmr::get_default_resource())
+      : m_blocks(initial_block_, upstream_),
+        m_pools(std::pmr::pool_options{0, LARGEST_POOLED}, &m_blocks) {}
+
+  Arena(const Arena&)            = delete;
+  Arena& operator=(const Arena&) = delete;
+
+  // hand this to a Registry (or any pmr container); not thread-safe
+  std::pmr::memory_resource* Resource() noexcept {
+    return &m_pools;
+  }
+
+  // frees every allocation made through Resource(); nothing allocated from
+  // it may be used afterwards, see Registry::Clear
+  void Release() noexcept {
+    m_pools.release();
+    m_blocks.release();
+  }
+
+ private:
+  std::pmr::monotonic_buffer_resource m_blocks;
+  std::pmr::unsynchronized_pool_resource m_pools;
+};
+
+}  // namespace SECSY
@@ -0,0 +1,18 @@
+#pragma once
+
+// Inlining hints in the spelling each compiler understands; elsewhere they
+// expand to nothing rather than to an attribute the compiler warns about.
+// Placed first in a declaration, ahead of the return type.
+#if defined(__GNUC__) || defined(__clang__)
+#define SECSY_FORCE_INLINE [[gnu::always_inline]]
+#define SECSY_NOINLINE [[gnu::noinline]]
+#define SECSY_COLD [[gnu::cold]]
+#elif defined(_MSC_VER)
+#define SECSY_FORCE_INLINE __forceinline
+#define SECSY_NOINLINE __declspec(noinline)
+#define SECSY_COLD
+#else
+#define SECSY_FORCE_INLINE
+#define SECSY_NOINLINE
+#define SECSY_COLD
+#endif
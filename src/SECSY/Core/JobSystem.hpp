@@ -0,0 +1,225 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace SECSY {
+
+// Fixed pool of worker threads, each with its own job deque. A worker pops
+// its newest job first and, once out of work, steals the oldest job of
+// another worker. The thread that submits work helps run it until done.
+class JobSystem {
+ public:
+  using size_type = std::size_t;
+
+  // one less than the hardware threads: the calling thread takes part too
+  JobSystem() : JobSystem(DefaultWorkerCount()) {}
+
+  explicit JobSystem(size_type workers_) : m_queues(workers_) {
+    m_threads.reserve(workers_);
+    for (size_type i = 0; i < workers_; ++i) {
+      m_threads.emplace_back([this, i] { WorkerLoop(i); });
+    }
+  }
+
+  JobSystem(const JobSystem&)            = delete;
+  JobSystem& operator=(const JobSystem&) = delete;
+
+  ~JobSystem() {
+    {
+      std::lock_guard lock(m_wake_mutex);
+      m_stop = true;
+    }
+    m_wake.notify_all();
+    for (auto& thread : m_threads) {
+      thread.join();
+    }
+  }
+
+  size_type WorkerCount() const noexcept {
+    return m_threads.size();
+  }
+
+  // Calls func_(begin, end) for consecutive chunks of chunk_ items covering
+  // [0, count_) and returns once all of them ran. Chunk boundaries depend
+  // only on count_ and chunk_, never on the number of threads, so work split
+  // per chunk is reproducible. The first exception thrown is rethrown here.
+  template <typename Func_>
+  void ParallelFor(size_type count_, size_type chunk_, Func_&& func_) {
+    if (count_ == 0) {
+      return;
+    }
+    chunk_ = std::max<size_type>(chunk_, 1);
+
+    size_type chunks = (count_ + chunk_ - 1) / chunk_;
+    if (chunks == 1 || m_queues.empty()) {
+      for (size_type begin = 0; begin < count_; begin += chunk_) {
+        func_(begin, std::min(begin + chunk_, count_));
+      }
+      return;
+    }
+
+    using func_type = std::remove_reference_t<Func_>;
+    Batch batch;
+    batch.run  = &RunChunk<func_type>;
+    batch.func = std::addressof(func_);
+    batch.pending.store(chunks, std::memory_order_relaxed);
+
+    // deal chunks round-robin, the submitting thread only steals
+    size_type pushed = 0;
+    try {
+      for (; pushed < chunks; ++pushed) {
+        size_type begin = pushed * chunk_;
+        Push(pushed % m_queues.size(),
+             Job{&batch, begin, std::min(begin + chunk_, count_)});
+      }
+    } catch (...) {
+      // the jobs already queued point at batch: drop the ones never pushed
+      // and let the rest finish before batch goes out of scope
+      batch.pending.fetch_sub(chunks - pushed, std::memory_order_acq_rel);
+      Help(batch);
+      throw;
+    }
+
+    Help(batch);
+    if (batch.error) {
+      std::rethrow_exception(batch.error);
+    }
+  }
+
+ private:
+  // one ParallelFor call; lives on the submitting thread's stack
+  struct Batch {
+    void (*run)(void*, size_type, size_type){nullptr};
+    void* func{nullptr};
+    std::atomic<size_type> pending{0};
+    std::mutex error_mutex;
+    std::exception_ptr error;
+  };
+
+  struct Job {
+    Batch* batch{nullptr};
+    size_type begin{0};
+    size_type end{0};
+  };
+
+  struct Queue {
+    std::mutex mutex;
+    std::deque<Job> jobs;
+  };
+
+  static size_type DefaultWorkerCount() noexcept {
+    unsigned hw = std::thread::hardware_concurrency();
+    return hw > 1 ? hw - 1 : 0;
+  }
+
+  template <typename Func_>
+  static void RunChunk(void* func_, size_type begin_, size_type end_) {
+    (*static_cast<Func_*>(func_))(begin_, end_);
+  }
+
+  // runs queued jobs on the calling thread until batch_ has none pending
+  void Help(const Batch& batch_) {
+    while (batch_.pending.load(std::memory_order_acquire) != 0) {
+      Job job;
+      if (TrySteal(0, job)) {
+        Run(job);
+      } else {
+        std::this_thread::yield();
+      }
+    }
+  }
+
+  static void Run(const Job& job_) noexcept {
+    Batch& batch = *job_.batch;
+    try {
+      batch.run(batch.func, job_.begin, job_.end);
+    } catch (...) {
+      std::lock_guard lock(batch.error_mutex);
+      if (!batch.error) {
+        batch.error = std::current_exception();
+      }
+    }
+    batch.pending.fetch_sub(1, std::memory_order_acq_rel);
+  }
+
+  void Push(size_type queue_, Job job_) {
+    {
+      std::lock_guard lock(m_queues[queue_].mutex);
+      m_queues[queue_].jobs.push_back(job_);
+    }
+    {
+      std::lock_guard lock(m_wake_mutex);
+      ++m_queued;
+    }
+    m_wake.notify_one();
+  }
+
+  bool TryPopOwn(size_type queue_, Job& job_) {
+    std::lock_guard lock(m_queues[queue_].mutex);
+    auto& jobs = m_queues[queue_].jobs;
+    if (jobs.empty()) {
+      return false;
+    }
+    job_ = jobs.back();
+    jobs.pop_back();
+    TakeQueued();
+    return true;
+  }
+
+  // oldest job of any queue, scanning from first_
+  bool TrySteal(size_type first_, Job& job_) {
+    for (size_type n = 0; n < m_queues.size(); ++n) {
+      auto& queue = m_queues[(first_ + n) % m_queues.size()];
+      std::lock_guard lock(queue.mutex);
+      if (!queue.jobs.empty()) {
+        job_ = queue.jobs.front();
+        queue.jobs.pop_front();
+        TakeQueued();
+        return true;
+      }
+    }
+    return false;
+  }
+
+  void TakeQueued() {
+    std::lock_guard lock(m_wake_mutex);
+    --m_queued;
+  }
+
+  void WorkerLoop(size_type index_) {
+    for (;;) {
+      Job job;
+      if (TryPopOwn(index_, job) || TrySteal(index_ + 1, job)) {
+        Run(job);
+        continue;
+      }
+
+      std::unique_lock lock(m_wake_mutex);
+      m_wake.wait(lock, [this] { return m_stop || m_queued != 0; });
+      if (m_stop) {
+        return;
+      }
+    }
+  }
+
+  std::vector<Queue> m_queues;  // one per worker
+  std::vector<std::thread> m_threads;
+
+  std::mutex m_wake_mutex;  // guards m_queued and m_stop
+  std::condition_variable m_wake;
+  size_type m_queued{0};  // jobs sitting in any queue
+  bool m_stop{false};
+};
+
+}  // namespace SECSY
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#if __has_include(<sys/mman.h>)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define SECSY_HAS_MMAP 1
+#else
+#define SECSY_HAS_MMAP 0
+#endif
+
+namespace SECSY {
+
+// Read-only view of a whole file. Memory-mapped where the platform has
+// mmap, so pages are read in by the kernel as they are touched; elsewhere
+// the file is read into memory up front.
+class MappedFile {
+ public:
+  explicit MappedFile(const std::filesystem::path& path_) {
+#if SECSY_HAS_MMAP
+    int fd = ::open(path_.c_str(), O_RDONLY);
+    if (fd < 0) {
+      throw std::runtime_error("cannot open " + path_.string());
+    }
+
+    struct stat info {};
+    if (::fstat(fd, &info) != 0) {
+      ::close(fd);
+      throw std::runtime_error("cannot stat " + path_.string());
+    }
+
+    m_size = static_cast<std::size_t>(info.st_size);
+    if (m_size != 0) {
+      void* map = ::mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+      if (map == MAP_FAILED) {
+        ::close(fd);
+        throw std::runtime_error("cannot map " + path_.string());
+      }
+      ::madvise(map, m_size, MADV_SEQUENTIAL);
+      m_data = static_cast<const std::byte*>(map);
+    }
+    ::close(fd);  // the mapping stays valid
+#else
+    std::ifstream file(path_, std::ios::binary | std::ios::ate);
+    if (!file) {
+      throw std::runtime_error("cannot open " + path_.string());
+    }
+    m_buffer.resize(static_cast<std::size_t>(file.tellg()));
+    file.seekg(0);
+    file.read(reinterpret_cast<char*>(m_buffer.data()),
+              static_cast<std::streamsize>(m_buffer.size()));
+    m_data = m_buffer.data();
+    m_size = m_buffer.size();
+#endif
+  }
+
+  MappedFile(const MappedFile&)            = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+
+  ~MappedFile() {
+#if SECSY_HAS_MMAP
+    if (m_data) {
+      ::munmap(const_cast<std::byte*>(m_data), m_size);
+    }
+#endif
+  }
+
+  std::span<const std::byte> Bytes() const noexcept {
+    return {m_data, m_size};
+  }
+
+ private:
+  const std::byte* m_data{nullptr};
+  std::size_t m_size{0};
+#if !SECSY_HAS_MMAP
+  std::vector<std::byte> m_buffer;
+#endif
+};
+
+}  // namespace SECSY
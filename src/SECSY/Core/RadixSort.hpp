@@ -0,0 +1,86 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace SECSY {
+
+// Stable LSD radix sort of 64-bit keys, carrying a 32-bit value along with
+// each key (typically an index into the records being ordered). One read
+// builds the digit histograms of every pass; passes where all keys share
+// the digit are skipped, so keys that only use a few low bits of each half
+// (small layer and texture ids, say) cost two or three passes. Scratch
+// space is kept between calls.
+class RadixSorter {
+ public:
+  using size_type  = std::size_t;
+  using key_type   = std::uint64_t;
+  using value_type = std::uint32_t;
+
+  static constexpr size_type DIGIT_BITS = 8;
+  static constexpr size_type PASSES     = 64 / DIGIT_BITS;
+
+  // sorts keys_ ascending and applies the same permutation to values_;
+  // equal keys keep their relative order. The spans must have equal sizes.
+  void Sort(std::span<key_type> keys_, std::span<value_type> values_) {
+    const size_type size = keys_.size();
+    if (size < 2) {
+      return;
+    }
+
+    std::array<std::array<size_type, RADIX>, PASSES> counts{};
+    for (key_type key : keys_) {
+      for (size_type pass = 0; pass < PASSES; ++pass) {
+        ++counts[pass][Digit(key, pass)];
+      }
+    }
+
+    m_keys.resize(size);
+    m_values.resize(size);
+    std::span<key_type> keys_out(m_keys);
+    std::span<value_type> values_out(m_values);
+
+    for (size_type pass = 0; pass < PASSES; ++pass) {
+      auto& count = counts[pass];
+      if (count[Digit(keys_[0], pass)] == size) {
+        continue;  // every key has this digit
+      }
+
+      size_type offset = 0;
+      for (auto& bucket : count) {
+        offset += std::exchange(bucket, offset);
+      }
+      for (size_type i = 0; i < size; ++i) {
+        size_type target   = count[Digit(keys_[i], pass)]++;
+        keys_out[target]   = keys_[i];
+        values_out[target] = values_[i];
+      }
+      std::swap(keys_, keys_out);
+      std::swap(values_, values_out);
+    }
+
+    // an odd number of passes leaves the result in the scratch buffers
+    if (keys_.data() == m_keys.data()) {
+      std::copy(keys_.begin(), keys_.end(), keys_out.begin());
+      std::copy(values_.begin(), values_.end(), values_out.begin());
+    }
+  }
+
+ private:
+  static constexpr size_type RADIX = size_type{1} << DIGIT_BITS;
+
+  static size_type Digit(key_type key_, size_type pass_) noexcept {
+    return static_cast<size_type>((key_ >> (pass_ * DIGIT_BITS)) &
+                                  (RADIX - 1));
+  }
+
+  std::vector<key_type> m_keys;
+  std::vector<value_type> m_values;
+};
+
+}  // namespace SECSY
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <utility>
+#include <vector>
+
+namespace SECSY {
+
+// List of listeners called in connection order on Publish. Connect hands
+// out an id that Disconnect takes back. A listener must not connect to or
+// disconnect from the signal that is calling it.
+template <typename... Args_>
+class Signal {
+ public:
+  using size_type  = std::size_t;
+  using listener   = std::function<void(Args_...)>;
+  using connection = std::size_t;
+
+  template <typename Func_>
+  connection Connect(Func_&& func_) {
+    connection id = m_next++;
+    m_listeners.push_back(Slot{id, listener(std::forward<Func_>(func_))});
+    return id;
+  }
+
+  // no-op for an unknown or already disconnected id
+  void Disconnect(connection id_) noexcept {
+    std::erase_if(m_listeners, [&](const Slot& slot) { return slot.id == id_; });
+  }
+
+  void Clear() noexcept {
+    m_listeners.clear();
+  }
+
+  void Publish(Args_... args_) const {
+    for (const auto& slot : m_listeners) {
+      slot.func(args_...);
+    }
+  }
+
+  size_type Size() const noexcept {
+    return m_listeners.size();
+  }
+
+  bool Empty() const noexcept {
+    return m_listeners.empty();
+  }
+
+ private:
+  struct Slot {
+    connection id;
+    listener func;
+  };
+
+  std::vector<Slot> m_listeners;
+  connection m_next{0};
+};
+
+}  // namespace SECSY
@@ -0,0 +1,170 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <vector>
+
+namespace SECSY {
+
+// Packs rectangles into a fixed-size bin, one at a time and without moving
+// earlier ones, so content streamed in later still fits around what is
+// there. The free space is tracked as a skyline, the top edge of
+// everything placed so far, as a list of horizontal segments; each
+// rectangle goes where its top ends lowest (bottom-left rule), ties going
+// to the position that wastes the least area under it. Space buried under
+// the skyline is never reused, which is what keeps inserts cheap: a
+// rectangle costs a pass over the segments. Feeding rectangles tallest
+// first packs noticeably tighter.
+class SkylinePacker {
+ public:
+  using size_type = std::size_t;
+
+  struct Rect {
+    std::int32_t x, y, width, height;
+
+    bool operator==(const Rect&) const = default;
+  };
+
+  SkylinePacker(std::int32_t width_, std::int32_t height_)
+      : m_width(width_), m_height(height_) {
+    Clear();
+  }
+
+  // where a width_ x height_ rectangle went, or nothing if it does not fit
+  std::optional<Rect> Insert(std::int32_t width_, std::int32_t height_) {
+    if (width_ <= 0 || height_ <= 0 || width_ > m_width) {
+      return std::nullopt;
+    }
+
+    size_type best          = NONE;
+    std::int32_t best_y     = 0;
+    std::int64_t best_top   = std::numeric_limits<std::int64_t>::max();
+    std::int64_t best_waste = std::numeric_limits<std::int64_t>::max();
+    for (size_type i = 0; i < m_skyline.size(); ++i) {
+      std::int32_t y;
+      std::int64_t waste;
+      if (!Fit(i, width_, height_, y, waste)) {
+        continue;
+      }
+      std::int64_t top = std::int64_t{y} + height_;
+      if (top < best_top || (top == best_top && waste < best_waste)) {
+        best       = i;
+        best_y     = y;
+        best_top   = top;
+        best_waste = waste;
+      }
+    }
+    if (best == NONE) {
+      return std::nullopt;
+    }
+
+    Rect placed{m_skyline[best].x, best_y, width_, height_};
+    Place(best, placed);
+    m_used += std::int64_t{width_} * height_;
+    return placed;
+  }
+
+  // forgets every rectangle
+  void Clear() {
+    m_skyline.assign(1, Segment{0, 0, m_width});
+    m_used = 0;
+  }
+
+  // share of the bin covered by rectangles, 0 to 1
+  double Occupancy() const noexcept {
+    return static_cast<double>(m_used) /
+           (static_cast<double>(m_width) * m_height);
+  }
+
+  std::int32_t Width() const noexcept {
+    return m_width;
+  }
+
+  std::int32_t Height() const noexcept {
+    return m_height;
+  }
+
+ private:
+  static constexpr size_type NONE = static_cast<size_type>(-1);
+
+  struct Segment {
+    std::int32_t x, y, width;
+  };
+
+  // Can a rectangle with its left edge at segment first_ sit on the
+  // skyline? It rests on the highest segment under it; waste_ is the area
+  // left between the skyline and its bottom.
+  bool Fit(size_type first_,
+           std::int32_t width_,
+           std::int32_t height_,
+           std::int32_t& y_,
+           std::int64_t& waste_) const noexcept {
+    const std::int32_t left = m_skyline[first_].x;
+    if (left + width_ > m_width) {
+      return false;
+    }
+
+    y_ = 0;
+    for (size_type i = first_;
+         i < m_skyline.size() && m_skyline[i].x < left + width_;
+         ++i) {
+      if (m_skyline[i].y > y_) {
+        y_ = m_skyline[i].y;
+      }
+    }
+    if (y_ + height_ > m_height) {
+      return false;
+    }
+
+    waste_ = 0;
+    for (size_type i = first_;
+         i < m_skyline.size() && m_skyline[i].x < left + width_;
+         ++i) {
+      std::int32_t right = m_skyline[i].x + m_skyline[i].width;
+      std::int32_t span  = std::min(right, left + width_) - m_skyline[i].x;
+      waste_ += std::int64_t{y_ - m_skyline[i].y} * span;
+    }
+    return true;
+  }
+
+  // raises the skyline over rect_, which starts at segment at_
+  void Place(size_type at_, const Rect& rect_) {
+    const std::int32_t right = rect_.x + rect_.width;
+    m_skyline.insert(m_skyline.begin() + at_,
+                     Segment{rect_.x, rect_.y + rect_.height, rect_.width});
+
+    // trim or drop the segments now under the rectangle
+    size_type next = at_ + 1;
+    while (next < m_skyline.size() && m_skyline[next].x < right) {
+      Segment& segment = m_skyline[next];
+      std::int32_t end = segment.x + segment.width;
+      if (end <= right) {
+        m_skyline.erase(m_skyline.begin() + next);
+        continue;
+      }
+      segment.width = end - right;
+      segment.x     = right;
+      break;
+    }
+
+    // neighbours at the same height become one segment
+    for (size_type i = 0; i + 1 < m_skyline.size();) {
+      if (m_skyline[i].y == m_skyline[i + 1].y) {
+        m_skyline[i].width += m_skyline[i + 1].width;
+        m_skyline.erase(m_skyline.begin() + i + 1);
+      } else {
+        ++i;
+      }
+    }
+  }
+
+  std::int32_t m_width;
+  std::int32_t m_height;
+  std::vector<Segment> m_skyline;  // left to right, covering the width
+  std::int64_t m_used{0};
+};
+
+}  // namespace SECSY
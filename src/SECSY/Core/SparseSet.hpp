@@ -1,16 +1,33 @@
 #pragma once
 
+#include <algorithm>
 #include <cstddef>
 #include <limits>
+#include <memory>
 #include <stdexcept>
 #include <type_traits>
 #include <utility>
 #include <vector>
 
+#include "Compiler.hpp"
+
 namespace SECSY {
 
-template <typename T_, typename Size_ = std::size_t>
+// Dense array of values plus a sparse index from value to dense position.
+// The sparse index is split into fixed-size pages that are only allocated
+// once a value in their range is added, so memory follows the live values
+// rather than the largest one ever seen. Size_ is the type stored in the
+// sparse pages; std::uint32_t halves the index footprint. Dense array and
+// pages all come from Allocator_ (rebound as needed), so a
+// std::pmr::polymorphic_allocator puts the whole set on one memory resource.
+template <typename T_,
+          typename Size_        = std::size_t,
+          std::size_t PageSize_ = 4096,
+          typename Allocator_   = std::allocator<T_>>
 class SparseSet {
+  static_assert(PageSize_ > 0 && (PageSize_ & (PageSize_ - 1)) == 0,
+                "page size must be a power of two");
+
  public:
   using size_type       = Size_;
   using value_type      = T_;
@@ -18,43 +35,121 @@ class SparseSet {
   using const_reference = const T_&;
   using pointer         = T_*;
   using const_pointer   = const T_*;
+  using allocator_type  = Allocator_;
 
   static constexpr size_type npos = std::numeric_limits<size_type>::max();
 
-  SparseSet(size_type capacity_ = 0) {
-    m_sparse.resize(capacity_, npos);
+  static constexpr std::size_t PAGE_SIZE = PageSize_;
+
+  // pre-allocates the pages covering keys [0, capacity_)
+  explicit SparseSet(size_type capacity_            = 0,
+                     const allocator_type& alloc_ = allocator_type())
+      : m_dense(alloc_), m_sparse(sparse_allocator(alloc_)) {
+    for (std::size_t key = 0; key < capacity_; key += PAGE_SIZE) {
+      EnsurePage(key);
+    }
+  }
+
+  explicit SparseSet(const allocator_type& alloc_) : SparseSet(0, alloc_) {}
+
+  allocator_type get_allocator() const noexcept {
+    return m_dense.get_allocator();
   }
 
   void Add(value_type e_) {
-    if (Contains(e_)) {
-      return;
+    IndexOrAdd(e_);
+  }
+
+  // dense position of e_, appending it first if missing; a single sparse
+  // lookup either way, so bulk inserts do not pay for Contains + Add. A
+  // value sharing e_'s key (e.g. an older version of an entity) is
+  // replaced by e_ in place, so one key never holds two dense entries.
+  size_type IndexOrAdd(value_type e_) {
+    size_type& slot = EnsurePage(Key(e_));  // may throw, nothing changed yet
+    if (slot != npos) {
+      m_dense[slot] = e_;
+      return slot;
     }
 
-    EnsureCapacity(e_);
-    m_sparse[static_cast<size_type>(e_)] = m_dense.size();
     m_dense.push_back(e_);
+    slot = static_cast<size_type>(m_dense.size() - 1);
+    return slot;
   }
 
   void Remove(value_type e_) {
-    if (!Contains(e_)) {
+    size_type index = Index(e_);
+    if (index == npos) {
       return;
     }
 
-    size_type index = m_sparse[static_cast<size_type>(e_)];
-    value_type last = m_dense.back();
-    m_dense[index]  = last;
-    m_sparse[static_cast<size_type>(last)] = index;
+    value_type last   = m_dense.back();
+    m_dense[index]    = last;
+    SlotOf(Key(last)) = index;
     m_dense.pop_back();
-    m_sparse[static_cast<size_type>(e_)] = npos;
+    SlotOf(Key(e_)) = npos;
   }
 
+  // exact match: the dense entry must compare equal to e_, so handles that
+  // share a key but differ otherwise (e.g. entity versions) are rejected
   bool Contains(value_type e_) const {
-    return static_cast<size_type>(e_) < m_sparse.size() &&
-           m_sparse[static_cast<size_type>(e_)] != npos;
+    return Index(e_) != npos;
+  }
+
+  // dense position of e_, or npos. Forced inline: view iteration probes
+  // every pool through this, and GCC stops inlining it on its own once a
+  // program calls it from enough places.
+  SECSY_FORCE_INLINE size_type Index(value_type e_) const {
+    std::size_t key  = Key(e_);
+    std::size_t page = key / PAGE_SIZE;
+    if (page >= m_sparse.size() || m_sparse[page].empty()) {
+      return npos;
+    }
+
+    size_type index = m_sparse[page][key % PAGE_SIZE];
+    return (index != npos && m_dense[index] == e_) ? index : npos;
+  }
+
+  // swaps two dense positions, keeping the sparse index in sync
+  void Swap(size_type lhs_, size_type rhs_) noexcept {
+    std::swap(m_dense[lhs_], m_dense[rhs_]);
+    SlotOf(Key(m_dense[lhs_])) = lhs_;
+    SlotOf(Key(m_dense[rhs_])) = rhs_;
+  }
+
+  // Writes e_, already in the set, to dense position index_ and points its
+  // sparse slot there. For moving entries in bulk, e.g. along a
+  // permutation: whatever was at index_ must have been saved or placed
+  // elsewhere, and e_'s old position gets overwritten in turn.
+  void Place(size_type index_, value_type e_) noexcept {
+    m_dense[index_] = e_;
+    SlotOf(Key(e_)) = index_;
+  }
+
+  void Reserve(size_type capacity_) {
+    m_dense.reserve(capacity_);
+  }
+
+  void Clear() noexcept {
+    for (const auto& e : m_dense) {
+      SlotOf(Key(e)) = npos;
+    }
+    m_dense.clear();
   }
 
   size_type Size() const {
-    return m_dense.size();
+    return static_cast<size_type>(m_dense.size());
+  }
+
+  bool Empty() const {
+    return m_dense.empty();
+  }
+
+  // number of sparse pages currently allocated
+  std::size_t PageCount() const {
+    return static_cast<std::size_t>(
+        std::count_if(m_sparse.begin(), m_sparse.end(), [](const auto& page) {
+          return !page.empty();
+        }));
   }
 
   const_pointer Data() const {
@@ -96,17 +191,39 @@ class SparseSet {
   }
 
  private:
-  using dense_storage  = std::vector<value_type>;
-  using sparse_storage = std::vector<size_type>;
+  template <typename U_>
+  using rebind = typename std::allocator_traits<
+      allocator_type>::template rebind_alloc<U_>;
+
+  // a page is either empty (not allocated) or exactly PAGE_SIZE slots;
+  // containers keep copies deep and moves allocator-correct
+  using page_type        = std::vector<size_type, rebind<size_type>>;
+  using sparse_allocator = rebind<page_type>;
+  using dense_storage    = std::vector<value_type, allocator_type>;
+  using sparse_storage   = std::vector<page_type, sparse_allocator>;
+
+  static std::size_t Key(value_type e_) noexcept {
+    return static_cast<std::size_t>(e_);
+  }
 
-  void EnsureCapacity(value_type e_) {
-    if (static_cast<size_type>(e_) >= m_sparse.size()) {
-      m_sparse.resize(static_cast<size_type>(e_) + 1, npos);
+  // only valid for keys whose page is known to exist
+  size_type& SlotOf(std::size_t key_) noexcept {
+    return m_sparse[key_ / PAGE_SIZE][key_ % PAGE_SIZE];
+  }
+
+  size_type& EnsurePage(std::size_t key_) {
+    std::size_t page = key_ / PAGE_SIZE;
+    if (page >= m_sparse.size()) {
+      m_sparse.resize(page + 1, page_type(m_dense.get_allocator()));
+    }
+    if (m_sparse[page].empty()) {
+      m_sparse[page] = page_type(PAGE_SIZE, npos, m_dense.get_allocator());
     }
+    return SlotOf(key_);
   }
 
   dense_storage m_dense;
   sparse_storage m_sparse;
 };
 
-}  // namespace SECSY
\ No newline at end of file
+}  // namespace SECSY
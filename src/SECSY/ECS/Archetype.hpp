@@ -0,0 +1,254 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "ComponentStorage.hpp"
+#include "Entity.hpp"
+#include "Signature.hpp"
+
+#ifndef SECSY_CHUNK_BYTES
+#define SECSY_CHUNK_BYTES 16384  // bytes per archetype chunk
+#endif
+
+namespace Internal {
+
+// Type-erased operations on one component type, so archetypes can move
+// and destroy columns without knowing their types
+struct ComponentInfo {
+  ComponentID id;
+  std::size_t size;
+  std::size_t align;
+  void (*move_construct)(void* dst_, void* src_) noexcept;
+  void (*destroy)(void* ptr_) noexcept;
+
+  template <typename T_>
+  static ComponentInfo Of() noexcept {
+    static_assert(std::is_nothrow_move_constructible_v<T_>,
+                  "archetype components are relocated between chunks");
+    return ComponentInfo{
+        TypeID<T_>(),
+        sizeof(T_),
+        alignof(T_),
+        [](void* dst_, void* src_) noexcept {
+          std::construct_at(static_cast<T_*>(dst_),
+                            std::move(*static_cast<T_*>(src_)));
+        },
+        [](void* ptr_) noexcept { std::destroy_at(static_cast<T_*>(ptr_)); }};
+  }
+};
+
+// All entities that have exactly the same set of components. Rows live in
+// fixed-size chunks; inside a chunk every component type (and the owning
+// entities) is its own contiguous array, so a system touching a few types
+// streams through a few arrays of the same chunk. Rows stay packed: removal
+// moves the last row into the gap.
+class Archetype {
+ public:
+  using size_type = std::size_t;
+
+  static constexpr size_type npos        = static_cast<size_type>(-1);
+  static constexpr size_type CHUNK_BYTES = SECSY_CHUNK_BYTES;
+
+  // infos_ must be sorted by id and match the bits of signature_
+  Archetype(Signature signature_, std::vector<const ComponentInfo*> infos_)
+      : m_signature(signature_), m_infos(std::move(infos_)) {
+    m_column_of.fill(npos);
+    for (size_type c = 0; c < m_infos.size(); ++c) {
+      m_column_of[m_infos[c]->id] = c;
+      m_align = std::max(m_align, m_infos[c]->align);
+    }
+    m_offsets.resize(m_infos.size());
+
+    size_type row_bytes = sizeof(::SECSY::Entity);
+    for (const auto* info : m_infos) {
+      row_bytes += info->size;
+    }
+
+    m_capacity = std::max<size_type>(CHUNK_BYTES / row_bytes, 1);
+    while (m_capacity > 1 && Layout(m_capacity) > CHUNK_BYTES) {
+      --m_capacity;
+    }
+    m_chunk_bytes = std::max(Layout(m_capacity), CHUNK_BYTES);
+  }
+
+  Archetype(const Archetype&)            = delete;
+  Archetype& operator=(const Archetype&) = delete;
+
+  ~Archetype() {
+    while (m_size != 0) {
+      RemoveRow(m_size - 1);
+    }
+  }
+
+  const Signature& Types() const noexcept {
+    return m_signature;
+  }
+
+  bool Has(ComponentID id_) const noexcept {
+    return id_ < Signature::CAPACITY && m_column_of[id_] != npos;
+  }
+
+  // column of a component type, or npos
+  size_type ColumnOf(ComponentID id_) const noexcept {
+    return m_column_of[id_];
+  }
+
+  size_type Size() const noexcept {
+    return m_size;
+  }
+
+  // rows per chunk
+  size_type Capacity() const noexcept {
+    return m_capacity;
+  }
+
+  // chunks holding at least one row
+  size_type ChunkCount() const noexcept {
+    return (m_size + m_capacity - 1) / m_capacity;
+  }
+
+  // rows in use in chunk_ < ChunkCount(); only the last one can be partial
+  size_type ChunkSize(size_type chunk_) const noexcept {
+    return std::min(m_capacity, m_size - chunk_ * m_capacity);
+  }
+
+  ::SECSY::Entity* Entities(size_type chunk_) const noexcept {
+    return reinterpret_cast<::SECSY::Entity*>(m_chunks[chunk_].get());
+  }
+
+  void* Column(size_type chunk_, size_type column_) const noexcept {
+    return m_chunks[chunk_].get() + m_offsets[column_];
+  }
+
+  // T_ may be const-qualified, e.g. for a read-only view
+  template <typename T_>
+  T_* Column(size_type chunk_) const noexcept {
+    return static_cast<T_*>(
+        Column(chunk_, m_column_of[TypeID<std::remove_const_t<T_>>()]));
+  }
+
+  void* At(size_type row_, size_type column_) const noexcept {
+    return static_cast<std::byte*>(Column(row_ / m_capacity, column_)) +
+           (row_ % m_capacity) * m_infos[column_]->size;
+  }
+
+  template <typename T_>
+  T_* At(size_type row_) const noexcept {
+    return static_cast<T_*>(
+        At(row_, m_column_of[TypeID<std::remove_const_t<T_>>()]));
+  }
+
+  ::SECSY::Entity EntityAt(size_type row_) const noexcept {
+    return Entities(row_ / m_capacity)[row_ % m_capacity];
+  }
+
+  // appends a row for e_ and returns it; its components are left
+  // unconstructed for the caller to fill in
+  size_type PushRow(::SECSY::Entity e_) {
+    if (m_size == m_chunks.size() * m_capacity) {
+      m_chunks.emplace_back(
+          static_cast<std::byte*>(
+              ::operator new(m_chunk_bytes, std::align_val_t{m_align})),
+          ChunkDeleter{m_align});
+    }
+    size_type row = m_size++;
+    Entities(row / m_capacity)[row % m_capacity] = e_;
+    return row;
+  }
+
+  // undoes the last PushRow before any component of it was constructed
+  void PopRow() noexcept {
+    --m_size;
+    ReleaseSpareChunk();
+  }
+
+  // destroys the components of row_ and moves the last row into its place;
+  // returns the entity that moved, or Null if row_ was the last one
+  ::SECSY::Entity RemoveRow(size_type row_) noexcept {
+    size_type last = m_size - 1;
+    for (size_type c = 0; c < m_infos.size(); ++c) {
+      const auto* info = m_infos[c];
+      info->destroy(At(row_, c));
+      if (row_ != last) {
+        info->move_construct(At(row_, c), At(last, c));
+        info->destroy(At(last, c));
+      }
+    }
+
+    ::SECSY::Entity moved = ::SECSY::Entity::Null;
+    if (row_ != last) {
+      moved = EntityAt(last);
+      Entities(row_ / m_capacity)[row_ % m_capacity] = moved;
+    }
+
+    --m_size;
+    ReleaseSpareChunk();
+    return moved;
+  }
+
+  const std::vector<const ComponentInfo*>& Infos() const noexcept {
+    return m_infos;
+  }
+
+  // cached transitions: archetype reached by adding / removing one type
+  Archetype*& AddEdge(ComponentID id_) noexcept {
+    return m_add_edges[id_];
+  }
+
+  Archetype*& RemoveEdge(ComponentID id_) noexcept {
+    return m_remove_edges[id_];
+  }
+
+ private:
+  struct ChunkDeleter {
+    std::size_t align;
+    void operator()(std::byte* ptr_) const noexcept {
+      ::operator delete(ptr_, std::align_val_t{align});
+    }
+  };
+
+  using chunk_ptr = std::unique_ptr<std::byte[], ChunkDeleter>;
+
+  // bytes used by a chunk of capacity_ rows; fills in the column offsets
+  size_type Layout(size_type capacity_) noexcept {
+    size_type offset = capacity_ * sizeof(::SECSY::Entity);
+    for (size_type c = 0; c < m_infos.size(); ++c) {
+      size_type align = m_infos[c]->align;
+      offset          = (offset + align - 1) / align * align;
+      m_offsets[c]    = offset;
+      offset += capacity_ * m_infos[c]->size;
+    }
+    return offset;
+  }
+
+  // drops the last chunk once it is empty, keeping at most one spare
+  void ReleaseSpareChunk() noexcept {
+    if (m_chunks.size() > 1 &&
+        m_size <= (m_chunks.size() - 2) * m_capacity) {
+      m_chunks.pop_back();
+    }
+  }
+
+  Signature m_signature;
+  std::vector<const ComponentInfo*> m_infos;  // one per column, by id
+  std::vector<size_type> m_offsets;           // column offsets in a chunk
+  std::array<size_type, Signature::CAPACITY> m_column_of;
+
+  size_type m_align{alignof(::SECSY::Entity)};
+  size_type m_capacity{0};
+  size_type m_chunk_bytes{0};
+  size_type m_size{0};
+  std::vector<chunk_ptr> m_chunks;
+
+  std::array<Archetype*, Signature::CAPACITY> m_add_edges{};
+  std::array<Archetype*, Signature::CAPACITY> m_remove_edges{};
+};
+
+}  // namespace Internal
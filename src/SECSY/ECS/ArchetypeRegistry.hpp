@@ -0,0 +1,500 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "Archetype.hpp"
+#include "ComponentStorage.hpp"
+#include "Entity.hpp"
+#include "Signature.hpp"
+#include "../Core/JobSystem.hpp"
+
+namespace Internal {
+
+template <typename... Components_>
+class ArchetypeViewIterator {
+ public:
+  using size_type       = std::size_t;
+  using view_tuple      = std::tuple<::SECSY::Entity, Components_&...>;
+  using archetype_list  = std::vector<Archetype*>;
+
+  ArchetypeViewIterator(const archetype_list* archetypes_, size_type index_)
+      : m_archetypes(archetypes_), m_archetype(index_) {
+    SkipEmpty();
+  }
+
+  view_tuple operator*() const {
+    return std::apply(
+        [&](auto*... columns) {
+          return view_tuple(m_entities[m_row], columns[m_row]...);
+        },
+        m_columns);
+  }
+
+  ArchetypeViewIterator& operator++() {
+    if (++m_row == m_rows) {
+      m_row = 0;
+      ++m_chunk;
+      SkipEmpty();
+    }
+    return *this;
+  }
+
+  bool operator==(const ArchetypeViewIterator& other) const {
+    return m_archetype == other.m_archetype && m_chunk == other.m_chunk &&
+           m_row == other.m_row;
+  }
+  bool operator!=(const ArchetypeViewIterator& other) const {
+    return !(*this == other);
+  }
+
+ private:
+  // moves to the next chunk with rows and loads its column pointers
+  void SkipEmpty() {
+    for (; m_archetype < m_archetypes->size(); ++m_archetype, m_chunk = 0) {
+      Archetype* archetype = (*m_archetypes)[m_archetype];
+      if (m_chunk < archetype->ChunkCount()) {
+        m_rows     = archetype->ChunkSize(m_chunk);
+        m_entities = archetype->Entities(m_chunk);
+        m_columns  = {archetype->template Column<Components_>(m_chunk)...};
+        return;
+      }
+    }
+    m_chunk = 0;
+  }
+
+  const archetype_list* m_archetypes;
+  size_type m_archetype;
+  size_type m_chunk{0};
+  size_type m_row{0};
+  size_type m_rows{0};
+  ::SECSY::Entity* m_entities{nullptr};
+  std::tuple<Components_*...> m_columns{};
+};
+
+// Every archetype holding all of Components_, walked chunk by chunk. No
+// per-entity lookups: a chunk is a set of parallel arrays.
+template <typename... Components_>
+class ArchetypeView {
+ public:
+  using size_type      = std::size_t;
+  using iterator       = ArchetypeViewIterator<Components_...>;
+  using archetype_list = std::vector<Archetype*>;
+
+  ArchetypeView() = default;
+
+  explicit ArchetypeView(archetype_list archetypes_)
+      : m_archetypes(std::move(archetypes_)) {}
+
+  iterator begin() const {
+    return iterator(&m_archetypes, 0);
+  }
+
+  iterator end() const {
+    return iterator(&m_archetypes, m_archetypes.size());
+  }
+
+  // exact number of matches
+  size_type SizeHint() const noexcept {
+    size_type size = 0;
+    for (const auto* archetype : m_archetypes) {
+      size += archetype->Size();
+    }
+    return size;
+  }
+
+  // calls func_(entity, components...) for every match
+  template <typename Func_>
+  void Each(Func_&& func_) const {
+    for (auto* archetype : m_archetypes) {
+      for (size_type c = 0; c < archetype->ChunkCount(); ++c) {
+        EachIn(*archetype, c, func_);
+      }
+    }
+  }
+
+  // Each, with every chunks_ archetype chunks forming one job on jobs_.
+  // func_ must only touch the entity it is given.
+  template <typename Func_>
+  void ParallelEach(::SECSY::JobSystem& jobs_,
+                    Func_&& func_,
+                    size_type chunks_ = 1) const {
+    std::vector<std::pair<Archetype*, size_type>> work;
+    for (auto* archetype : m_archetypes) {
+      for (size_type c = 0; c < archetype->ChunkCount(); ++c) {
+        work.emplace_back(archetype, c);
+      }
+    }
+
+    jobs_.ParallelFor(work.size(), chunks_, [&](size_type begin_,
+                                                size_type end_) {
+      for (size_type i = begin_; i < end_; ++i) {
+        EachIn(*work[i].first, work[i].second, func_);
+      }
+    });
+  }
+
+ private:
+  template <typename Func_>
+  static void EachIn(Archetype& archetype_, size_type chunk_, Func_& func_) {
+    size_type rows                 = archetype_.ChunkSize(chunk_);
+    const ::SECSY::Entity* entities = archetype_.Entities(chunk_);
+    std::tuple<Components_*...> columns{
+        archetype_.template Column<Components_>(chunk_)...};
+
+    for (size_type i = 0; i < rows; ++i) {
+      std::apply(
+          [&](auto*... ptrs) { func_(entities[i], ptrs[i]...); }, columns);
+    }
+  }
+
+  archetype_list m_archetypes;
+};
+
+}  // namespace Internal
+
+namespace SECSY {
+
+// Alternative to Registry that stores entities by archetype: every distinct
+// component set gets its own table of fixed-size chunks (SECSY_CHUNK_BYTES),
+// laid out as one array per component. Views iterate whole chunks with no
+// per-entity lookup, at the price of moving an entity's components to
+// another table whenever a component is added or removed. The transitions
+// are cached on the archetypes, so repeated Emplace/Remove patterns skip the
+// archetype search.
+//
+// Offers the same entity and component surface as Registry (Create, Destroy,
+// IsAlive, Emplace, Insert, Get, Has, Remove, View), so code written against
+// SECSY::World works with either layout. Components must be nothrow
+// move-constructible.
+class ArchetypeRegistry {
+ public:
+  ArchetypeRegistry() {
+    m_archetypes.push_back(std::make_unique<::Internal::Archetype>(
+        ::Internal::Signature{},
+        std::vector<const ::Internal::ComponentInfo*>{}));
+    m_root = m_archetypes.back().get();
+  }
+
+  ArchetypeRegistry(const ArchetypeRegistry&)            = delete;
+  ArchetypeRegistry& operator=(const ArchetypeRegistry&) = delete;
+
+  Entity Create() {
+    Entity::id_type id;
+
+    if (m_free_head != 0) {
+      id          = m_free_head;
+      m_free_head = m_slots[id].id;
+      m_slots[id] = Entity{id, m_slots[id].ver};
+    } else {
+      if (m_slots.size() > Entity::MAX_ID) {
+        throw std::length_error("entity ids exhausted");
+      }
+      id = static_cast<Entity::id_type>(m_slots.size());
+      m_slots.emplace_back(id, 1);
+      m_records.emplace_back();
+    }
+
+    try {
+      m_records[id] = Record{m_root, m_root->PushRow(m_slots[id])};
+    } catch (...) {
+      FreeSlot(m_slots[id]);
+      throw;
+    }
+    return m_slots[id];
+  }
+
+  template <std::forward_iterator It_>
+  void Create(It_ first_, It_ last_) {
+    auto count = static_cast<std::size_t>(std::distance(first_, last_));
+    m_slots.reserve(m_slots.size() + count);
+    m_records.reserve(m_records.size() + count);
+    for (; first_ != last_; ++first_) {
+      *first_ = Create();
+    }
+  }
+
+  void Destroy(Entity e_) {
+    if (!IsAlive(e_)) {
+      return;
+    }
+
+    Record& record = m_records[e_.id];
+    Relink(record.archetype->RemoveRow(record.row), record.row);
+    FreeSlot(e_);
+  }
+
+  bool IsAlive(Entity e_) const noexcept {
+    return e_.id < m_slots.size() && m_slots[e_.id] == e_;
+  }
+
+  template <typename T_, typename... Args_>
+  T_& Emplace(Entity e_, Args_&&... args_) {
+    if (!IsAlive(e_)) {
+      throw std::out_of_range("Emplace() on non-alive entity");
+    }
+
+    auto id        = EnsureInfo<T_>();
+    Record& record = m_records[e_.id];
+    if (record.archetype->Has(id)) {
+      return Overwrite<T_>(record, std::forward<Args_>(args_)...);
+    }
+    return Append<T_>(record,
+                      AddTarget(record.archetype, id),
+                      e_,
+                      std::forward<Args_>(args_)...);
+  }
+
+  // emplaces a copy of value_ for every entity in [first_, last_); all of
+  // them are checked before anything changes
+  template <typename T_, std::forward_iterator It_>
+  void Insert(It_ first_, It_ last_, const T_& value_ = {}) {
+    InsertEach<T_>(first_, last_, [&]() -> const T_& { return value_; });
+  }
+
+  // same, but the i-th entity gets the i-th element starting at from_
+  template <typename T_, std::forward_iterator It_, std::input_iterator From_>
+  void Insert(It_ first_, It_ last_, From_ from_) {
+    InsertEach<T_>(first_, last_, [&]() -> decltype(auto) {
+      return *from_++;
+    });
+  }
+
+  template <typename T_>
+  const T_& Get(Entity e_) const {
+    if (!IsAlive(e_)) {
+      throw std::out_of_range("entity is not alive");
+    }
+
+    const Record& record = m_records[e_.id];
+    if (!record.archetype->Has(::Internal::TypeID<T_>())) {
+      throw std::out_of_range("component not found for entity");
+    }
+    return *record.archetype->template At<T_>(record.row);
+  }
+
+  template <typename T_>
+  T_& Get(Entity e_) {
+    return const_cast<T_&>(std::as_const(*this).template Get<T_>(e_));
+  }
+
+  template <typename T_>
+  bool Has(Entity e_) const noexcept {
+    return IsAlive(e_) &&
+           m_records[e_.id].archetype->Has(::Internal::TypeID<T_>());
+  }
+
+  template <typename T_>
+  void Remove(Entity e_) {
+    if (!Has<T_>(e_)) {
+      return;
+    }
+
+    Record& record = m_records[e_.id];
+    auto* to       = RemoveTarget(record.archetype, ::Internal::TypeID<T_>());
+    MoveRow(record, to, to->PushRow(e_));
+  }
+
+  // Components_ may be const-qualified for read-only access; there are no
+  // change ticks here, so const only guards the references handed out
+  template <typename... Components_>
+  auto View() {
+    ::Internal::Signature mask;
+    for (auto id :
+         {::Internal::TypeID<std::remove_const_t<Components_>>()...}) {
+      if (id >= ::Internal::Signature::CAPACITY) {
+        return ::Internal::ArchetypeView<Components_...>();
+      }
+      mask.Set(id);
+    }
+
+    std::vector<::Internal::Archetype*> matches;
+    for (auto& archetype : m_archetypes) {
+      if (archetype->Size() != 0 && archetype->Types().Contains(mask)) {
+        matches.push_back(archetype.get());
+      }
+    }
+    return ::Internal::ArchetypeView<Components_...>(std::move(matches));
+  }
+
+  // number of distinct component sets seen so far, including the empty one
+  std::size_t ArchetypeCount() const noexcept {
+    return m_archetypes.size();
+  }
+
+ private:
+  // where an entity's row lives
+  struct Record {
+    ::Internal::Archetype* archetype{nullptr};
+    std::size_t row{0};
+  };
+
+  // assigns T_(args_...) to the T_ in record_'s row, as ComponentStorage
+  // does: a throwing constructor runs into a temporary first, so the old
+  // value survives if it throws
+  template <typename T_, typename... Args_>
+  T_& Overwrite(const Record& record_, Args_&&... args_) {
+    T_& comp = *record_.archetype->template At<T_>(record_.row);
+    if constexpr (std::is_nothrow_constructible_v<T_, Args_...>) {
+      std::destroy_at(std::addressof(comp));
+      std::construct_at(std::addressof(comp), std::forward<Args_>(args_)...);
+    } else {
+      T_ tmp(std::forward<Args_>(args_)...);
+      std::destroy_at(std::addressof(comp));
+      std::construct_at(std::addressof(comp), std::move(tmp));
+    }
+    return comp;
+  }
+
+  // moves e_ from record_'s archetype into to_, which has a T_ on top
+  template <typename T_, typename... Args_>
+  T_& Append(Record& record_,
+             ::Internal::Archetype* to_,
+             Entity e_,
+             Args_&&... args_) {
+    auto row = to_->PushRow(e_);
+    try {
+      std::construct_at(to_->template At<T_>(row),
+                        std::forward<Args_>(args_)...);
+    } catch (...) {
+      to_->PopRow();
+      throw;
+    }
+
+    MoveRow(record_, to_, row);
+    return *to_->template At<T_>(row);
+  }
+
+  // Emplace with next_() for each entity; the target archetype is looked
+  // up once per run of entities coming from the same archetype, which is
+  // every entity for a fresh batch
+  template <typename T_, typename It_, typename Next_>
+  void InsertEach(It_ first_, It_ last_, Next_ next_) {
+    if (!std::all_of(first_, last_, [&](Entity e) { return IsAlive(e); })) {
+      throw std::out_of_range("Insert() on non-alive entity");
+    }
+
+    auto id                     = EnsureInfo<T_>();
+    ::Internal::Archetype* from = nullptr;
+    ::Internal::Archetype* to   = nullptr;
+    for (; first_ != last_; ++first_) {
+      Entity e       = *first_;
+      Record& record = m_records[e.id];
+      if (record.archetype->Has(id)) {
+        Overwrite<T_>(record, next_());
+        continue;
+      }
+      if (record.archetype != from) {
+        from = record.archetype;
+        to   = AddTarget(from, id);
+      }
+      Append<T_>(record, to, e, next_());
+    }
+  }
+
+  template <typename T_>
+  ::Internal::ComponentID EnsureInfo() {
+    auto id = ::Internal::TypeID<T_>();
+    if (id >= ::Internal::Signature::CAPACITY) {
+      throw std::length_error("too many component types, raise "
+                              "SECSY_MAX_COMPONENTS");
+    }
+
+    if (id >= m_infos.size()) {
+      m_infos.resize(id + 1);
+    }
+    if (!m_infos[id]) {
+      m_infos[id] = std::make_unique<::Internal::ComponentInfo>(
+          ::Internal::ComponentInfo::Of<T_>());
+    }
+    return id;
+  }
+
+  ::Internal::Archetype* AddTarget(::Internal::Archetype* from_,
+                                   ::Internal::ComponentID id_) {
+    auto*& edge = from_->AddEdge(id_);
+    if (!edge) {
+      auto types = from_->Types();
+      types.Set(id_);
+      edge = FindOrCreate(types);
+      edge->RemoveEdge(id_) = from_;
+    }
+    return edge;
+  }
+
+  ::Internal::Archetype* RemoveTarget(::Internal::Archetype* from_,
+                                      ::Internal::ComponentID id_) {
+    auto*& edge = from_->RemoveEdge(id_);
+    if (!edge) {
+      auto types = from_->Types();
+      types.Reset(id_);
+      edge = FindOrCreate(types);
+      edge->AddEdge(id_) = from_;
+    }
+    return edge;
+  }
+
+  // only reached when no cached edge leads to types_
+  ::Internal::Archetype* FindOrCreate(const ::Internal::Signature& types_) {
+    for (auto& archetype : m_archetypes) {
+      if (archetype->Types() == types_) {
+        return archetype.get();
+      }
+    }
+
+    std::vector<const ::Internal::ComponentInfo*> infos;
+    types_.ForEach([&](std::size_t id) { infos.push_back(m_infos[id].get()); });
+    m_archetypes.push_back(
+        std::make_unique<::Internal::Archetype>(types_, std::move(infos)));
+    return m_archetypes.back().get();
+  }
+
+  // moves the components record_ shares with to_ into row_, then drops the
+  // old row; components only in the old archetype are destroyed
+  void MoveRow(Record& record_, ::Internal::Archetype* to_, std::size_t row_) {
+    auto* from = record_.archetype;
+    for (std::size_t c = 0; c < from->Infos().size(); ++c) {
+      std::size_t column = to_->ColumnOf(from->Infos()[c]->id);
+      if (column != ::Internal::Archetype::npos) {
+        from->Infos()[c]->move_construct(to_->At(row_, column),
+                                         from->At(record_.row, c));
+      }
+    }
+
+    std::size_t old_row = record_.row;
+    record_             = Record{to_, row_};
+    Relink(from->RemoveRow(old_row), old_row);
+  }
+
+  // points moved_ (filled into row_ by a swap-and-pop) at its new row
+  void Relink(Entity moved_, std::size_t row_) noexcept {
+    if (moved_ != Entity::Null) {
+      m_records[moved_.id].row = row_;
+    }
+  }
+
+  void FreeSlot(Entity e_) noexcept {
+    Entity::ver_type ver = (e_.ver == Entity::MAX_VERSION) ? 1 : e_.ver + 1;
+    m_slots[e_.id]       = Entity{m_free_head, ver};
+    m_free_head          = e_.id;
+  }
+
+  // slot per entity id, same free-list scheme as Registry
+  std::vector<Entity> m_slots{Entity{1, 0}};
+  std::vector<Record> m_records{Record{}};
+  Entity::id_type m_free_head{0};
+
+  // indexed by TypeID, filled on first Emplace of a type
+  std::vector<std::unique_ptr<::Internal::ComponentInfo>> m_infos;
+  std::vector<std::unique_ptr<::Internal::Archetype>> m_archetypes;
+  ::Internal::Archetype* m_root;  // no components
+};
+
+}  // namespace SECSY
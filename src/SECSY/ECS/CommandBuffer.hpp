@@ -0,0 +1,291 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "ComponentStorage.hpp"
+#include "Entity.hpp"
+#include "Registry.hpp"
+#include "Signature.hpp"
+
+namespace Internal {
+
+// Pending emplaces and removes of one component type
+struct ICommandQueue {
+  virtual ~ICommandQueue() = default;
+
+  // apply everything to registry_; created_ resolves pending handles
+  virtual void Flush(SECSY::Registry& registry_,
+                     const std::vector<SECSY::Entity>& created_)    = 0;
+  virtual void Append(ICommandQueue& other_,
+                      SECSY::Entity::id_type offset_)               = 0;
+  virtual void OffsetPending(SECSY::Entity::id_type offset_) noexcept = 0;
+  virtual bool Empty() const noexcept                               = 0;
+};
+
+// A pending handle stands for the n-th entity created by the same buffer.
+// It has version 0, which no live entity ever has, and id n + 1.
+inline bool IsPending(SECSY::Entity e_) noexcept {
+  return e_.ver == 0 && e_.id != 0;
+}
+
+inline SECSY::Entity Resolve(SECSY::Entity e_,
+                             const std::vector<SECSY::Entity>& created_) {
+  return IsPending(e_) ? created_[e_.id - 1] : e_;
+}
+
+inline SECSY::Entity Rebase(SECSY::Entity e_,
+                            SECSY::Entity::id_type offset_) noexcept {
+  return IsPending(e_) ? SECSY::Entity{e_.id + offset_, 0} : e_;
+}
+
+template <typename T_>
+class CommandQueue : public ICommandQueue {
+ public:
+  template <typename... Args_>
+  void Emplace(SECSY::Entity e_, Args_&&... args_) {
+    m_values.emplace_back(std::forward<Args_>(args_)...);
+    try {
+      m_emplaced.push_back(e_);
+    } catch (...) {
+      m_values.pop_back();
+      throw;
+    }
+  }
+
+  void Remove(SECSY::Entity e_) {
+    m_removed.push_back(Removal{e_, m_emplaced.size()});
+  }
+
+  // Emplaces go in as one batched Insert, dead targets are dropped first.
+  // Removes follow, except those an emplace of the same entity was
+  // recorded after, so the end state is that of applying them in order.
+  void Flush(SECSY::Registry& registry_,
+             const std::vector<SECSY::Entity>& created_) override {
+    // recorded position of the last emplace per entity, taken before dead
+    // targets are compacted away; only needed when both kinds of command
+    // are queued
+    std::unordered_map<SECSY::Entity, std::size_t> last_emplace;
+    if (!m_removed.empty()) {
+      for (std::size_t i = 0; i < m_emplaced.size(); ++i) {
+        last_emplace[Resolve(m_emplaced[i], created_)] = i;
+      }
+    }
+
+    std::size_t live = 0;
+    for (std::size_t i = 0; i < m_emplaced.size(); ++i) {
+      SECSY::Entity e = Resolve(m_emplaced[i], created_);
+      if (!registry_.IsAlive(e)) {
+        continue;
+      }
+      if (live != i) {
+        m_values[live] = std::move(m_values[i]);
+      }
+      m_emplaced[live++] = e;
+    }
+
+    registry_.Insert<T_>(m_emplaced.begin(),
+                         m_emplaced.begin() + live,
+                         std::make_move_iterator(m_values.begin()));
+
+    for (const Removal& removal : m_removed) {
+      SECSY::Entity e = Resolve(removal.entity, created_);
+      if (auto it = last_emplace.find(e);
+          it != last_emplace.end() && it->second >= removal.before) {
+        continue;  // emplaced again after the remove
+      }
+      registry_.Remove<T_>(e);
+    }
+
+    m_emplaced.clear();
+    m_values.clear();
+    m_removed.clear();
+  }
+
+  void Append(ICommandQueue& other_,
+              SECSY::Entity::id_type offset_) override {
+    auto& other      = static_cast<CommandQueue&>(other_);
+    std::size_t base = m_emplaced.size();
+
+    m_values.reserve(m_values.size() + other.m_values.size());
+    for (std::size_t i = 0; i < other.m_values.size(); ++i) {
+      Emplace(Rebase(other.m_emplaced[i], offset_),
+              std::move(other.m_values[i]));
+    }
+    for (const Removal& removal : other.m_removed) {
+      m_removed.push_back(
+          Removal{Rebase(removal.entity, offset_), base + removal.before});
+    }
+
+    other.m_emplaced.clear();
+    other.m_values.clear();
+    other.m_removed.clear();
+  }
+
+  void OffsetPending(SECSY::Entity::id_type offset_) noexcept override {
+    for (SECSY::Entity& e : m_emplaced) {
+      e = Rebase(e, offset_);
+    }
+    for (Removal& removal : m_removed) {
+      removal.entity = Rebase(removal.entity, offset_);
+    }
+  }
+
+  bool Empty() const noexcept override {
+    return m_emplaced.empty() && m_removed.empty();
+  }
+
+ private:
+  struct Removal {
+    SECSY::Entity entity;
+    std::size_t before;  // emplaces recorded ahead of it
+  };
+
+  std::vector<SECSY::Entity> m_emplaced;  // parallel to m_values
+  std::vector<T_> m_values;
+  std::vector<Removal> m_removed;
+};
+
+}  // namespace Internal
+
+namespace SECSY {
+
+// Records structural changes to be applied to a Registry later, so systems
+// can queue them while iterating a View or Group. Create returns a pending
+// handle that is only meaningful to this buffer and becomes a real entity on
+// Flush. Flush applies, in this order: creates, emplaces, removes, destroys;
+// emplaces and removes are grouped by component type. For one entity and
+// type the outcome is that of the recorded order (a Remove then an Emplace
+// leaves the component in place), though the signals fired may differ.
+// Commands aimed at entities that are dead by then are skipped.
+//
+// If a command throws during Flush, the ones applied before it stay applied,
+// entities created by the flush included, the rest are dropped and the
+// buffer is left empty.
+//
+// A buffer is not thread-safe. Give each thread its own and Merge them into
+// one at a sync point before flushing.
+class CommandBuffer {
+ public:
+  Entity Create() {
+    if (m_created >= Entity::MAX_ID) {
+      throw std::length_error("too many pending entities in command buffer");
+    }
+    return Entity{++m_created, 0};
+  }
+
+  void Destroy(Entity e_) {
+    m_destroyed.push_back(e_);
+  }
+
+  template <typename T_, typename... Args_>
+  void Emplace(Entity e_, Args_&&... args_) {
+    EnsureQueue<T_>()->Emplace(e_, std::forward<Args_>(args_)...);
+  }
+
+  template <typename T_>
+  void Remove(Entity e_) {
+    EnsureQueue<T_>()->Remove(e_);
+  }
+
+  // moves other_'s commands behind this buffer's, renumbering its pending
+  // handles; other_ is left empty
+  void Merge(CommandBuffer& other_) {
+    if (other_.m_created > Entity::MAX_ID - m_created) {
+      throw std::length_error("too many pending entities in command buffer");
+    }
+    if (m_queues.size() < other_.m_queues.size()) {
+      m_queues.resize(other_.m_queues.size());
+    }
+
+    for (std::size_t id = 0; id < other_.m_queues.size(); ++id) {
+      auto& theirs = other_.m_queues[id];
+      if (!theirs) {
+        continue;
+      }
+      if (!m_queues[id]) {
+        m_queues[id] = std::move(theirs);  // nothing to merge into, adopt it
+        m_queues[id]->OffsetPending(m_created);
+        continue;
+      }
+      m_queues[id]->Append(*theirs, m_created);
+    }
+
+    m_destroyed.reserve(m_destroyed.size() + other_.m_destroyed.size());
+    for (Entity e : other_.m_destroyed) {
+      m_destroyed.push_back(::Internal::Rebase(e, m_created));
+    }
+
+    m_created += other_.m_created;
+    other_.Clear();
+  }
+
+  void Flush(Registry& registry_) {
+    try {
+      std::vector<Entity> created(m_created);
+      registry_.Create(created.begin(), created.end());
+
+      for (auto& queue : m_queues) {
+        if (queue && !queue->Empty()) {
+          queue->Flush(registry_, created);
+        }
+      }
+
+      for (Entity e : m_destroyed) {
+        registry_.Destroy(::Internal::Resolve(e, created));
+      }
+    } catch (...) {
+      Clear();  // pending handles mean nothing past this flush
+      throw;
+    }
+
+    m_destroyed.clear();
+    m_created = 0;
+  }
+
+  bool Empty() const noexcept {
+    return m_created == 0 && m_destroyed.empty() &&
+           std::all_of(m_queues.begin(), m_queues.end(), [](const auto& q) {
+             return !q || q->Empty();
+           });
+  }
+
+  void Clear() noexcept {
+    m_queues.clear();
+    m_destroyed.clear();
+    m_created = 0;
+  }
+
+ private:
+  // indexed by TypeID, like the registry's storage table
+  using queue_table = std::vector<std::unique_ptr<::Internal::ICommandQueue>>;
+
+  template <typename T_>
+  ::Internal::CommandQueue<T_>* EnsureQueue() {
+    auto id = ::Internal::TypeID<T_>();
+    if (id >= ::Internal::Signature::CAPACITY) {
+      throw std::length_error("too many component types, raise "
+                              "SECSY_MAX_COMPONENTS");
+    }
+
+    if (id >= m_queues.size()) {
+      m_queues.resize(id + 1);
+    }
+    if (!m_queues[id]) {
+      m_queues[id] = std::make_unique<::Internal::CommandQueue<T_>>();
+    }
+    return static_cast<::Internal::CommandQueue<T_>*>(m_queues[id].get());
+  }
+
+  queue_table m_queues;
+  std::vector<Entity> m_destroyed;
+  Entity::id_type m_created{0};  // pending handles handed out so far
+};
+
+}  // namespace SECSY
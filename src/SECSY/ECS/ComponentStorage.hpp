@@ -0,0 +1,821 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <numeric>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "Entity.hpp"
+#include "../Core/Compiler.hpp"
+#include "../Core/SparseSet.hpp"
+
+namespace SECSY {
+
+// Registry clock value, stamped on components as they are added or changed
+using Tick = std::uint32_t;
+
+}  // namespace SECSY
+
+namespace Internal {
+
+using ComponentID = std::size_t;
+
+inline ComponentID NextTypeID() noexcept {
+  static std::atomic<ComponentID> next{0};
+  return next.fetch_add(1, std::memory_order_relaxed);
+}
+
+// Dense sequential id (0, 1, 2, ...) per component type, assigned on first
+// use. Addresses signature bits and the registry's storage table directly.
+template <typename T_>
+ComponentID TypeID() noexcept {
+  static const ComponentID id = NextTypeID();
+  return id;
+}
+
+// Receives structural changes of the storages owned by a group
+struct IGroupHandler {
+  virtual ~IGroupHandler()                          = default;
+  virtual void OnEmplace(SECSY::Entity e_) noexcept = 0;
+  virtual void OnRemove(SECSY::Entity e_) noexcept  = 0;
+};
+
+// When a component slot was added and when it last changed
+struct ComponentTicks {
+  SECSY::Tick added;
+  SECSY::Tick changed;
+  std::uint32_t dirty{0};  // position in the pool's dirty list, if listed
+};
+
+// Stands in for the value array of an empty (tag) component type: there is
+// nothing to store per entity, so every slot is one shared instance and
+// only the element count is kept
+template <typename T_>
+class TagColumn {
+ public:
+  using size_type = std::size_t;
+
+  TagColumn() = default;
+
+  // matches the value vector's constructor; there is nothing to allocate
+  explicit TagColumn(std::pmr::memory_resource*) noexcept {}
+
+  template <typename... Args_>
+  T_& emplace_back(Args_&&... args_) {
+    // still honour throwing constructors
+    static_cast<void>(T_(std::forward<Args_>(args_)...));
+    ++m_size;
+    return Instance();
+  }
+
+  void pop_back() noexcept {
+    --m_size;
+  }
+
+  void reserve(size_type) noexcept {}
+
+  size_type size() const noexcept {
+    return m_size;
+  }
+
+  T_& back() const noexcept {
+    return Instance();
+  }
+
+  T_& operator[](size_type) const noexcept {
+    return Instance();
+  }
+
+  void clear() noexcept {
+    m_size = 0;
+  }
+
+  static T_& Instance() noexcept {
+    static T_ instance{};
+    return instance;
+  }
+
+ private:
+  size_type m_size{0};
+};
+
+struct Journal;
+
+// Base class for all storages
+struct IComponentStorage {
+  virtual ~IComponentStorage()                           = default;
+  virtual ComponentID TypeID() const noexcept            = 0;
+  virtual void Remove(SECSY::Entity e_) noexcept         = 0;
+  virtual void SetJournal(Journal* journal_) noexcept    = 0;
+  virtual void ClearDirty() noexcept                     = 0;
+};
+
+template <typename T_>
+class ComponentStorage;
+
+enum class UndoOp : std::uint8_t {
+  APPENDED,     // entity was appended to the pool
+  OVERWRITTEN,  // slot value and ticks were replaced (or handed out mutably)
+  REMOVED,      // entity was swap-and-popped out of the pool
+};
+
+// what an undone entry touched, so the registry can fix the signature bit
+struct Undone {
+  SECSY::Entity entity;
+  bool present;  // whether the entity has the component afterwards
+};
+
+struct IUndoLog {
+  virtual ~IUndoLog() = default;
+
+  // reverts the newest entry on storage_, which must be the pool that
+  // recorded it, with every later entry already reverted
+  virtual Undone UndoLast(IComponentStorage& storage_) = 0;
+  virtual void Clear() noexcept                         = 0;
+};
+
+// Undo entries recorded by one component pool, newest last
+template <typename T_>
+struct UndoLog : IUndoLog {
+  struct Entry {
+    UndoOp op;
+    std::uint32_t index;
+    SECSY::Entity entity;
+    ComponentTicks ticks;
+  };
+
+  std::vector<Entry> entries;
+  // previous values of OVERWRITTEN and REMOVED entries, in entry order
+  std::conditional_t<std::is_empty_v<T_>, TagColumn<T_>, std::vector<T_>>
+      values;
+
+  Undone UndoLast(IComponentStorage& storage_) override {
+    return static_cast<ComponentStorage<T_>&>(storage_).Undo(*this);
+  }
+
+  void Clear() noexcept override {
+    entries.clear();
+    values.clear();
+  }
+};
+
+// Undo entries of one recording (see SECSY::Delta): a log per component
+// type, plus the order entries were made in across the logs
+struct Journal {
+  static constexpr std::uint16_t REGISTRY = 0xFFFF;  // entity slot entries
+
+  SECSY::Tick since{0};  // slots changed before this are first touches
+  std::mutex mutex;      // first touches can come from several threads
+  std::vector<std::uint16_t> order;               // TypeID, or REGISTRY
+  std::vector<std::unique_ptr<IUndoLog>> logs;    // by TypeID
+
+  template <typename T_>
+  UndoLog<T_>& Log() {
+    auto id = ::Internal::TypeID<T_>();
+    if (id >= logs.size()) {
+      logs.resize(id + 1);
+    }
+    if (!logs[id]) {
+      logs[id] = std::make_unique<UndoLog<T_>>();
+    }
+    return static_cast<UndoLog<T_>&>(*logs[id]);
+  }
+
+  void Clear() noexcept {
+    order.clear();
+    for (auto& log : logs) {
+      if (log) {
+        log->Clear();
+      }
+    }
+  }
+};
+
+// Packed component pool: components live contiguously in m_data, in lockstep
+// with their owners in the paged sparse set m_entities, so every operation is
+// O(1) and removal is swap-and-pop. m_ticks follows the same layout and
+// records per slot when it was added and last changed, read from the clock
+// the owning registry hands in; the slots stamped at the current tick are
+// also listed in m_dirty. Empty component types (tags) keep no values
+// at all: the pool is just the entity set, and every entity shares one
+// static instance. All three arrays allocate from the memory resource given
+// on construction.
+template <typename T_>
+class ComponentStorage : public IComponentStorage {
+  using entity_set =
+      SECSY::SparseSet<SECSY::Entity,
+                       std::uint32_t,
+                       4096,
+                       std::pmr::polymorphic_allocator<SECSY::Entity>>;
+
+ public:
+  using size_type = entity_set::size_type;
+
+  static constexpr size_type npos = entity_set::npos;
+
+  static constexpr bool IS_TAG = std::is_empty_v<T_>;
+
+  explicit ComponentStorage(std::pmr::memory_resource* resource_ =
+                                std::pmr::get_default_resource())
+      : m_entities(entity_set::allocator_type(resource_)),
+        m_data(resource_),
+        m_ticks(resource_),
+        m_dirty(resource_) {}
+
+  ComponentID TypeID() const noexcept override {
+    return ::Internal::TypeID<T_>();
+  }
+
+  template <typename... Args_>
+  T_& Emplace(SECSY::Entity e_, Args_&&... args_) {
+    if (size_type index = Index(e_); index != npos) {
+      T_& comp = m_data[index];
+      if constexpr (IS_TAG) {
+        static_cast<void>(T_(std::forward<Args_>(args_)...));
+        Record(UndoOp::OVERWRITTEN, index, e_, comp);
+      } else if constexpr (std::is_nothrow_constructible_v<T_, Args_...> ||
+                    !std::is_nothrow_move_constructible_v<T_>) {
+        Record(UndoOp::OVERWRITTEN, index, e_, std::move(comp));
+        std::destroy_at(std::addressof(comp));
+        std::construct_at(std::addressof(comp), std::forward<Args_>(args_)...);
+      } else {
+        T_ tmp(std::forward<Args_>(args_)...);  // may throw; strong guarantee
+        Record(UndoOp::OVERWRITTEN, index, e_, std::move(comp));
+        std::destroy_at(std::addressof(comp));
+        std::construct_at(std::addressof(comp), std::move(tmp));
+      }
+      MarkChanged(index);
+      return comp;
+    }
+
+    ReserveDirty(Size() + 1);
+    if (size_type index = m_entities.IndexOrAdd(e_); index != m_data.size()) {
+      // e_ took over the slot of a stale handle with the same id
+      TakeOver(index);
+      return Emplace(e_, std::forward<Args_>(args_)...);
+    }
+    try {
+      m_ticks.push_back(ComponentTicks{*m_clock, *m_clock});
+      try {
+        m_data.emplace_back(std::forward<Args_>(args_)...);
+      } catch (...) {
+        m_ticks.pop_back();
+        throw;
+      }
+    } catch (...) {
+      m_entities.Remove(e_);  // e_ is last, nothing else moves
+      throw;
+    }
+    List(Size() - 1);
+    Record(UndoOp::APPENDED, Size() - 1, e_);
+
+    if (m_owner) {
+      m_owner->OnEmplace(e_);  // may move e_ into the group prefix
+      return m_data[m_entities.Index(e_)];
+    }
+    return m_data.back();
+  }
+
+  // emplaces a copy of value_ for every entity in [first_, last_), growing
+  // the pool once up front; entities that already have a T_ are overwritten.
+  // value_ may live in this pool: it is copied before the pool grows.
+  template <std::forward_iterator It_>
+  void Insert(It_ first_, It_ last_, const T_& value_) {
+    if constexpr (IS_TAG) {
+      InsertEach(first_, last_, [&]() -> const T_& { return value_; });
+    } else {
+      const T_ value(value_);
+      InsertEach(first_, last_, [&]() -> const T_& { return value; });
+    }
+  }
+
+  // same, but the i-th entity gets the i-th element starting at from_,
+  // which must not point into this pool
+  template <std::forward_iterator It_, std::input_iterator From_>
+  void Insert(It_ first_, It_ last_, From_ from_) {
+    InsertEach(first_, last_, [&]() -> decltype(auto) { return *from_++; });
+  }
+
+  // Appends count_ entities that are not in the pool yet, entities and
+  // values copied bytewise from entities_ and values_ (neither needs to be
+  // aligned). Used to load snapshots; tags take no values. Throws on a
+  // duplicate entity, keeping the ones appended before it.
+  void AppendRaw(const void* entities_,
+                 size_type count_,
+                 const void* values_)
+    requires(std::is_trivially_copyable_v<T_> &&
+             std::is_default_constructible_v<T_>)
+  {
+    size_type first = Size();
+    Reserve(first + count_);
+
+    bool duplicate = false;
+    const auto* bytes = static_cast<const std::byte*>(entities_);
+    for (size_type i = 0; i < count_; ++i) {
+      SECSY::Entity e;
+      std::memcpy(&e, bytes + i * sizeof(SECSY::Entity), sizeof(e));
+      if (size_type index = m_entities.IndexOrAdd(e); index != first + i) {
+        if (index < first) {
+          TakeOver(index);
+        }
+        count_    = i;
+        duplicate = true;
+        break;
+      }
+    }
+
+    if constexpr (IS_TAG) {
+      for (size_type i = 0; i < count_; ++i) {
+        m_data.emplace_back();
+      }
+    } else if (count_ != 0) {
+      m_data.resize(first + count_);
+      std::memcpy(m_data.data() + first, values_, count_ * sizeof(T_));
+    }
+    m_ticks.resize(first + count_, ComponentTicks{*m_clock, *m_clock});
+    for (size_type i = first; i < first + count_; ++i) {
+      List(i);
+    }
+
+    if (duplicate) {
+      throw std::invalid_argument("entity appended twice");
+    }
+  }
+
+  void Reserve(size_type capacity_) {
+    m_entities.Reserve(capacity_);
+    m_data.reserve(capacity_);
+    m_ticks.reserve(capacity_);
+    ReserveDirty(capacity_);
+  }
+
+  const T_& Get(SECSY::Entity e_) const {
+    size_type index = Index(e_);
+    if (index == npos) {
+      throw std::out_of_range("component not found for entity");
+    }
+    return m_data[index];
+  }
+
+  T_& Get(SECSY::Entity e_) {
+    return const_cast<T_&>(std::as_const(*this).Get(e_));
+  }
+
+  // nullptr instead of throwing when e_ has no T_
+  const T_* TryGet(SECSY::Entity e_) const noexcept {
+    size_type index = Index(e_);
+    return index != npos ? std::addressof(m_data[index]) : nullptr;
+  }
+
+  T_* TryGet(SECSY::Entity e_) noexcept {
+    return const_cast<T_*>(std::as_const(*this).TryGet(e_));
+  }
+
+  bool Has(SECSY::Entity e_) const noexcept {
+    return Index(e_) != npos;
+  }
+
+  void Remove(SECSY::Entity e_) noexcept override {
+    size_type index = Index(e_);
+    if (index == npos) {
+      return;
+    }
+
+    if (m_owner) {
+      m_owner->OnRemove(e_);  // moves e_ out of the group prefix first
+      index = Index(e_);
+    }
+
+    Record(UndoOp::REMOVED, index, e_, std::move(m_data[index]));
+    if (m_ticks[index].changed == *m_clock) {
+      Unlist(index);
+    }
+
+    // mirrors the swap-and-pop m_entities does below
+    if (size_type last = m_entities.Size() - 1; index != last) {
+      if constexpr (!IS_TAG) {
+        m_data[index] = std::move(m_data[last]);
+      }
+      m_ticks[index] = m_ticks[last];
+    }
+
+    m_data.pop_back();
+    m_ticks.pop_back();
+    m_entities.Remove(e_);
+  }
+
+  // swaps two packed positions, keeping the sparse index in sync
+  void SwapPositions(size_type lhs_, size_type rhs_) noexcept {
+    if (lhs_ == rhs_) {
+      return;
+    }
+
+    using std::swap;
+    if constexpr (!IS_TAG) {
+      swap(m_data[lhs_], m_data[rhs_]);
+    }
+    swap(m_ticks[lhs_], m_ticks[rhs_]);
+    m_entities.Swap(lhs_, rhs_);
+  }
+
+  // Sorts the pool in place by compare_, a strict weak order over
+  // (const T_&, const T_&) or, e.g. for tags, over (Entity, Entity). Not
+  // stable. The sort runs over positions; components, ticks and entities
+  // are then moved into place once each, see Permute.
+  template <typename Compare_>
+  void Sort(Compare_ compare_) {
+    std::vector<size_type> order(Size());
+    std::iota(order.begin(), order.end(), size_type{0});
+
+    if constexpr (std::is_invocable_r_v<bool,
+                                        Compare_&,
+                                        const T_&,
+                                        const T_&>) {
+      std::sort(order.begin(),
+                order.end(),
+                [&](size_type lhs_, size_type rhs_) {
+                  return compare_(std::as_const(m_data[lhs_]),
+                                  std::as_const(m_data[rhs_]));
+                });
+    } else {
+      const SECSY::Entity* entities = Entities();
+      std::sort(order.begin(),
+                order.end(),
+                [&](size_type lhs_, size_type rhs_) {
+                  return compare_(entities[lhs_], entities[rhs_]);
+                });
+    }
+    Permute(order);
+  }
+
+  // Moves the entities of [first_, last_) that have a T_ to the front of
+  // the pool, in that order; the others follow in no particular order.
+  // [first_, last_) must not repeat an entity.
+  void SortAs(const SECSY::Entity* first_,
+              const SECSY::Entity* last_) noexcept {
+    size_type next = 0;
+    for (; first_ != last_; ++first_) {
+      if (size_type index = Index(*first_); index != npos) {
+        SwapPositions(next++, index);
+      }
+    }
+  }
+
+  // packed position of e_, or npos if e_ (this exact version) has no T_;
+  // forced inline like SparseSet::Index
+  SECSY_FORCE_INLINE size_type Index(SECSY::Entity e_) const noexcept {
+    return m_entities.Index(e_);
+  }
+
+  // stamps the slot at index_ as changed now, listing it on the first
+  // change of the tick
+  void MarkChanged(size_type index_) noexcept {
+    if (m_ticks[index_].changed != *m_clock) {
+      m_ticks[index_].changed = *m_clock;
+      List(index_);
+    }
+  }
+
+  // Call as the slot at index_ is handed out mutably (Get, view and group
+  // iteration): logs it first if recording, then stamps it changed. Only
+  // the slots actually handed out are logged.
+  void Touch(size_type index_) noexcept {
+    if (m_journal) [[unlikely]] {
+      RecordTouch(index_);
+    }
+    MarkChanged(index_);
+  }
+
+  // changes are logged into journal_ until it is reset to null
+  void SetJournal(Journal* journal_) noexcept override {
+    m_journal = journal_;
+  }
+
+  // reverts the newest entry of log_, see IUndoLog::UndoLast
+  Undone Undo(UndoLog<T_>& log_) {
+    auto entry = log_.entries.back();
+    log_.entries.pop_back();
+
+    switch (entry.op) {
+      case UndoOp::APPENDED:  // the entity is still the last one
+        if (m_ticks.back().changed == *m_clock) {
+          Unlist(Size() - 1);
+        }
+        m_entities.Remove(entry.entity);
+        m_data.pop_back();
+        m_ticks.pop_back();
+        return Undone{entry.entity, false};
+
+      case UndoOp::OVERWRITTEN:
+        if constexpr (!IS_TAG) {
+          m_data[entry.index] = std::move(log_.values.back());
+        }
+        log_.values.pop_back();
+        RestoreTicks(entry.index, entry.ticks);
+        return Undone{entry.entity, true};
+
+      case UndoOp::REMOVED:  // append again, then undo the swap
+        ReserveDirty(Size() + 1);
+        m_entities.Add(entry.entity);
+        m_data.emplace_back(std::move(log_.values.back()));
+        log_.values.pop_back();
+        m_ticks.push_back(entry.ticks);
+        if (entry.ticks.changed == *m_clock) {
+          List(Size() - 1);
+        }
+        SwapPositions(entry.index, Size() - 1);
+        return Undone{entry.entity, true};
+    }
+    return Undone{entry.entity, Has(entry.entity)};
+  }
+
+  // clock read when stamping; must outlive the storage
+  void SetClock(const SECSY::Tick* clock_) noexcept {
+    m_clock = clock_;
+  }
+
+  // per-slot ticks, parallel to Entities()
+  const ComponentTicks* Ticks() const noexcept {
+    return m_ticks.data();
+  }
+
+  // Entities whose slot was added or changed at the current tick, each
+  // once, all still in the pool: what an Added/Changed view at this tick
+  // has to look at, however large the pool
+  const SECSY::Entity* Dirty() const noexcept {
+    return m_dirty.data();
+  }
+
+  size_type DirtySize() const noexcept {
+    return m_dirty_size.load(std::memory_order_relaxed);
+  }
+
+  // the tick Dirty() covers
+  SECSY::Tick DirtyTick() const noexcept {
+    return *m_clock;
+  }
+
+  // empties the dirty list; the registry calls this as its clock moves on
+  void ClearDirty() noexcept override {
+    m_dirty_size.store(0, std::memory_order_relaxed);
+  }
+
+  IGroupHandler* Owner() const noexcept {
+    return m_owner;
+  }
+
+  void SetOwner(IGroupHandler* owner_) noexcept {
+    m_owner = owner_;
+  }
+
+  size_type Size() const noexcept {
+    return m_entities.Size();
+  }
+
+  bool Empty() const noexcept {
+    return m_entities.Empty();
+  }
+
+  // packed owners, parallel to the components
+  const SECSY::Entity* Entities() const noexcept {
+    return m_entities.Data();
+  }
+
+  // component at packed position index_; the shared instance for tags
+  const T_& At(size_type index_) const noexcept {
+    return m_data[index_];
+  }
+
+  T_& At(size_type index_) noexcept {
+    return m_data[index_];
+  }
+
+  // contiguous components, parallel to Entities(); tags have none
+  const T_* Data() const noexcept
+    requires(!IS_TAG)
+  {
+    return m_data.data();
+  }
+
+  T_* Data() noexcept
+    requires(!IS_TAG)
+  {
+    return m_data.data();
+  }
+
+ private:
+  template <typename It_, typename Next_>
+  void InsertEach(It_ first_, It_ last_, Next_ next_) {
+    Reserve(Size() + static_cast<size_type>(std::distance(first_, last_)));
+
+    for (; first_ != last_; ++first_) {
+      // a new entity lands right behind the existing data
+      size_type index = m_entities.IndexOrAdd(*first_);
+      if (index != m_data.size()) {
+        TakeOver(index);
+        if constexpr (IS_TAG) {
+          static_cast<void>(next_());
+          Record(UndoOp::OVERWRITTEN, index, *first_, m_data[index]);
+        } else {
+          decltype(auto) value = next_();
+          Record(UndoOp::OVERWRITTEN, index, *first_, std::move(m_data[index]));
+          m_data[index] = std::forward<decltype(value)>(value);
+        }
+        MarkChanged(index);
+        continue;
+      }
+
+      try {
+        m_data.emplace_back(next_());
+        m_ticks.push_back(ComponentTicks{*m_clock, *m_clock});
+      } catch (...) {
+        if (m_data.size() > m_ticks.size()) {
+          m_data.pop_back();
+        }
+        m_entities.Remove(*first_);  // earlier entities keep their T_
+        throw;
+      }
+      List(index);
+      Record(UndoOp::APPENDED, index, *first_);
+
+      if (m_owner) {
+        m_owner->OnEmplace(*first_);
+      }
+    }
+  }
+
+  // logs how to undo a change about to be made to slot index_, taking the
+  // slot's previous value if one is given; a no-op unless recording
+  template <typename... Value_>
+  void Record(UndoOp op_,
+              size_type index_,
+              SECSY::Entity e_,
+              Value_&&... value_) noexcept {
+    if (m_journal) [[unlikely]] {
+      Journalize(op_, index_, e_, std::forward<Value_>(value_)...);
+    }
+  }
+
+  // out of line so the mutating paths stay small. Running out of memory
+  // here terminates.
+  template <typename... Value_>
+  SECSY_COLD SECSY_NOINLINE void Journalize(UndoOp op_,
+                                            size_type index_,
+                                            SECSY::Entity e_,
+                                            Value_&&... value_) noexcept {
+    auto& log = m_journal->template Log<T_>();
+    log.entries.push_back(typename UndoLog<T_>::Entry{
+        op_,
+        index_,
+        e_,
+        op_ == UndoOp::APPENDED ? ComponentTicks{} : m_ticks[index_]});
+    (log.values.emplace_back(std::forward<Value_>(value_)), ...);
+    m_journal->order.push_back(
+        static_cast<std::uint16_t>(::Internal::TypeID<T_>()));
+  }
+
+  // Reorders the pool so position i holds what was at order_[i]; order_
+  // is used up as the cycles are followed. Each cycle is rotated through
+  // one temporary: the first slot is lifted out, every other one moves
+  // once, into the place the previous one left, and the lifted slot fills
+  // the last hole.
+  void Permute(std::vector<size_type>& order_) noexcept {
+    for (size_type start = 0; start < order_.size(); ++start) {
+      if (order_[start] == start) {
+        continue;
+      }
+
+      SECSY::Entity entity        = Entities()[start];
+      ComponentTicks ticks        = m_ticks[start];
+      [[maybe_unused]] auto value = Lift(start);
+
+      size_type current = start;
+      while (order_[current] != start) {
+        size_type next = order_[current];
+        if constexpr (!IS_TAG) {
+          m_data[current] = std::move(m_data[next]);
+        }
+        m_ticks[current] = m_ticks[next];
+        m_entities.Place(current, Entities()[next]);
+        order_[current] = current;
+        current         = next;
+      }
+
+      if constexpr (!IS_TAG) {
+        m_data[current] = std::move(value);
+      }
+      m_ticks[current] = ticks;
+      m_entities.Place(current, entity);
+      order_[current] = current;
+    }
+  }
+
+  // moves the value at index_ out, for Permute; tags have none
+  auto Lift(size_type index_) noexcept {
+    if constexpr (IS_TAG) {
+      return nullptr;
+    } else {
+      return T_(std::move(m_data[index_]));
+    }
+  }
+
+  // The first touch of a slot since the recording began logs a copy of its
+  // value; later ones find it changed and log nothing. Move-only types are
+  // not logged. Safe to call from several threads, on distinct slots.
+  void RecordTouch(size_type index_) noexcept {
+    if constexpr (std::is_copy_constructible_v<T_> && !IS_TAG) {
+      if (!FirstTouch(index_)) {
+        return;
+      }
+      std::lock_guard lock(m_journal->mutex);
+      RecordValue(index_);
+    }
+  }
+
+  // whether the slot is unchanged since the recording began
+  bool FirstTouch(size_type index_) const noexcept {
+    return m_ticks[index_].changed < m_journal->since;
+  }
+
+  void RecordValue(size_type index_) noexcept {
+    Record(UndoOp::OVERWRITTEN,
+           index_,
+           Entities()[index_],
+           std::as_const(m_data[index_]));
+  }
+
+  // Appends the slot at index_, stamped now, to the dirty list. Each slot
+  // is listed at most once, so the list never outgrows the pool and
+  // ReserveDirty keeps it from allocating here; the atomic count lets
+  // views running in parallel list the slots they touch.
+  void List(size_type index_) noexcept {
+    size_type position =
+        m_dirty_size.fetch_add(1, std::memory_order_relaxed);
+    m_dirty[position]     = Entities()[index_];
+    m_ticks[index_].dirty = position;
+  }
+
+  // takes the listed slot at index_ off the dirty list, swap-and-pop
+  void Unlist(size_type index_) noexcept {
+    size_type position  = m_ticks[index_].dirty;
+    size_type last      = DirtySize() - 1;
+    SECSY::Entity moved = m_dirty[last];
+    m_dirty[position]   = moved;
+    m_dirty_size.store(last, std::memory_order_relaxed);
+    if (position != last) {
+      m_ticks[Index(moved)].dirty = position;
+    }
+  }
+
+  // room to list count_ slots; may throw, so call before changing anything
+  void ReserveDirty(size_type count_) {
+    if (m_dirty.size() < count_) {
+      m_dirty.resize(std::max<std::size_t>(count_, 2 * m_dirty.size()));
+    }
+  }
+
+  // The handle at index_ replaced a stale one with the same id (see
+  // SparseSet::IndexOrAdd); a listed slot is listed under the new handle.
+  void TakeOver(size_type index_) noexcept {
+    if (m_ticks[index_].changed == *m_clock) {
+      m_dirty[m_ticks[index_].dirty] = Entities()[index_];
+    }
+  }
+
+  // puts back logged ticks, keeping the dirty list in step with them
+  void RestoreTicks(size_type index_, ComponentTicks ticks_) noexcept {
+    if (m_ticks[index_].changed == *m_clock) {
+      Unlist(index_);
+    }
+    m_ticks[index_] = ticks_;
+    if (ticks_.changed == *m_clock) {
+      List(index_);
+    }
+  }
+
+  static constexpr SECSY::Tick NO_CLOCK = 0;
+
+  entity_set m_entities;
+  std::conditional_t<IS_TAG, TagColumn<T_>, std::pmr::vector<T_>> m_data;
+  std::pmr::vector<ComponentTicks> m_ticks;
+  const SECSY::Tick* m_clock{&NO_CLOCK};
+
+  // slots stamped at the current tick, in m_dirty[0, m_dirty_size)
+  std::pmr::vector<SECSY::Entity> m_dirty;
+  std::atomic<size_type> m_dirty_size{0};
+
+  IGroupHandler* m_owner{nullptr};  // group keeping this pool sorted, if any
+  Journal* m_journal{nullptr};      // recording in progress, if any
+};
+
+}  // namespace Internal
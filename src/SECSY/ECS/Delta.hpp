@@ -0,0 +1,71 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "ComponentStorage.hpp"
+#include "Entity.hpp"
+
+namespace SECSY {
+
+class Registry;
+
+// The changes a Registry made while recording into this delta (see
+// Registry::Record), each with what it replaced, so Registry::Rollback can
+// revert them newest first. Memory and rollback time follow the number of
+// changes, not the size of the world. Must outlive the recording.
+class Delta {
+ public:
+  using size_type = std::size_t;
+
+  Delta() = default;
+
+  Delta(const Delta&)            = delete;
+  Delta& operator=(const Delta&) = delete;
+
+  // entities created / destroyed while recording; one created and then
+  // destroyed again shows up in both
+  const std::vector<Entity>& Created() const noexcept {
+    return m_created;
+  }
+
+  const std::vector<Entity>& Destroyed() const noexcept {
+    return m_destroyed;
+  }
+
+  // recorded entries: entity slot writes plus component appends,
+  // overwrites, first mutable touches and removals
+  size_type Size() const noexcept {
+    return m_journal.order.size();
+  }
+
+  bool Empty() const noexcept {
+    return m_journal.order.empty();
+  }
+
+  // forgets the changes, committing them
+  void Clear() noexcept {
+    m_journal.Clear();
+    m_slots.clear();
+    m_created.clear();
+    m_destroyed.clear();
+  }
+
+ private:
+  friend class Registry;
+
+  // an entity slot before a write, or a slot appended to the table
+  struct SlotEntry {
+    Entity::id_type id;
+    Entity slot;
+    Entity::id_type free_head;
+    bool appended;
+  };
+
+  ::Internal::Journal m_journal;
+  std::vector<SlotEntry> m_slots;
+  std::vector<Entity> m_created;
+  std::vector<Entity> m_destroyed;
+};
+
+}  // namespace SECSY
@@ -1,66 +1,119 @@
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
-#include <tuple>
 #include <functional>
+#include <limits>
+#include <type_traits>
 
 namespace SECSY {
 
-struct Entity {
-  using id_type  = std::uint32_t;
-  using ver_type = std::uint8_t;
+// Describes how an entity handle splits one unsigned word into id and
+// version bits. More id bits allow more live entities, more version bits
+// delay the point where a recycled slot's version wraps around.
+template <typename Value_, std::size_t IdBits_>
+struct EntityTraits {
+  static_assert(std::is_unsigned_v<Value_>, "handle must be unsigned");
+  static_assert(IdBits_ > 0 && IdBits_ < std::numeric_limits<Value_>::digits,
+                "both id and version need at least one bit");
 
-  id_type id{};
-  ver_type ver{};
-  // we need to pad 3 bytes here, maybe group id and ver into 32 bits
+  using value_type = Value_;
 
-  constexpr Entity() noexcept                         = default;
-  constexpr Entity(const Entity&) noexcept            = default;
-  constexpr Entity& operator=(const Entity&) noexcept = default;
-  constexpr Entity(id_type id_, ver_type ver_) noexcept : id(id_), ver(ver_) {}
+  static constexpr std::size_t ID_BITS  = IdBits_;
+  static constexpr std::size_t VER_BITS =
+      std::numeric_limits<Value_>::digits - IdBits_;
+
+  static constexpr value_type ID_MASK  = (value_type{1} << ID_BITS) - 1;
+  static constexpr value_type VER_MASK = (value_type{1} << VER_BITS) - 1;
+};
+
+using EntityTraits20x12 = EntityTraits<std::uint32_t, 20>;  // ~1M ids
+using EntityTraits24x8  = EntityTraits<std::uint32_t, 24>;  // ~16M ids
+using EntityTraits32x32 = EntityTraits<std::uint64_t, 32>;  // huge worlds
+
+template <typename Traits_>
+struct BasicEntity {
+  using traits_type = Traits_;
+  using value_type  = typename Traits_::value_type;
+  using id_type     = value_type;
+  using ver_type    = value_type;
+
+  static constexpr id_type MAX_ID       = Traits_::ID_MASK;
+  static constexpr ver_type MAX_VERSION = Traits_::VER_MASK;
+
+  // packed into a single value_type, no padding
+  id_type id : Traits_::ID_BITS    = 0;
+  ver_type ver : Traits_::VER_BITS = 0;
+
+  constexpr BasicEntity() noexcept                              = default;
+  constexpr BasicEntity(const BasicEntity&) noexcept            = default;
+  constexpr BasicEntity& operator=(const BasicEntity&) noexcept = default;
+  constexpr BasicEntity(id_type id_, ver_type ver_) noexcept
+      : id(id_ & Traits_::ID_MASK), ver(ver_ & Traits_::VER_MASK) {}
 
   constexpr bool IsValid() const noexcept {
     return id != 0 && ver != 0;
   }
 
-  constexpr bool operator==(const Entity& other_) const noexcept {
-    return id == other_.id && ver == other_.ver;
+  // the whole handle as one word: version in the high bits, id in the low
+  constexpr value_type Value() const noexcept {
+    return static_cast<value_type>(id) |
+           (static_cast<value_type>(ver) << Traits_::ID_BITS);
   }
 
-  constexpr bool operator!=(const Entity& other_) const noexcept {
+  static constexpr BasicEntity FromValue(value_type value_) noexcept {
+    return BasicEntity(value_ & Traits_::ID_MASK,
+                       (value_ >> Traits_::ID_BITS) & Traits_::VER_MASK);
+  }
+
+  constexpr bool operator==(const BasicEntity& other_) const noexcept {
+    return Value() == other_.Value();
+  }
+
+  constexpr bool operator!=(const BasicEntity& other_) const noexcept {
     return !(*this == other_);
   }
 
-  constexpr bool operator<(const Entity& other_) const noexcept {
-    return std::tie(id, ver) < std::tie(other_.id, other_.ver);
+  // ordered by id first, then version
+  constexpr bool operator<(const BasicEntity& other_) const noexcept {
+    return id != other_.id ? id < other_.id : ver < other_.ver;
   }
 
-  constexpr bool operator>(const Entity& other_) const noexcept {
-    return std::tie(id, ver) > std::tie(other_.id, other_.ver);
+  constexpr bool operator>(const BasicEntity& other_) const noexcept {
+    return other_ < *this;
   }
 
+  // sparse containers are indexed by id only
   constexpr operator size_t() const noexcept {
     return static_cast<size_t>(id);
   }
 
-  static const Entity Null;
+  static const BasicEntity Null;
 };
 
-constexpr Entity Entity::Null = Entity{0, 0};
+template <typename Traits_>
+constexpr BasicEntity<Traits_> BasicEntity<Traits_>::Null =
+    BasicEntity<Traits_>{0, 0};
+
+#ifndef SECSY_ENTITY_TRAITS
+#define SECSY_ENTITY_TRAITS ::SECSY::EntityTraits20x12
+#endif
+
+// handle type used throughout the engine, see SECSY_ENTITY_TRAITS
+using Entity = BasicEntity<SECSY_ENTITY_TRAITS>;
+
+static_assert(sizeof(Entity) == sizeof(Entity::value_type),
+              "entity handle must pack into a single word");
 
 }  // namespace SECSY
 
 namespace std {
 
-template <>
-struct hash<SECSY::Entity> {
-  std::size_t operator()(const SECSY::Entity& e) const noexcept {
-    // using Boost Hash Combine Algorithm
-    std::size_t h = std::hash<SECSY::Entity::id_type>()(e.id);
-    h ^= std::hash<SECSY::Entity::ver_type>()(e.ver) + 0x9e3779b9 + (h << 6) +
-         (h >> 2);
-    return h;
+template <typename Traits_>
+struct hash<SECSY::BasicEntity<Traits_>> {
+  std::size_t operator()(const SECSY::BasicEntity<Traits_>& e) const noexcept {
+    return std::hash<typename Traits_::value_type>()(e.Value());
   }
 };
 
-}  // namespace std
\ No newline at end of file
+}  // namespace std
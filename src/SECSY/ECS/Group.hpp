@@ -0,0 +1,158 @@
+#pragma once
+
+#include <cstddef>
+#include <tuple>
+#include <utility>
+
+#include "ComponentStorage.hpp"
+#include "Entity.hpp"
+
+namespace Internal {
+
+// Keeps the owned storages co-sorted: every entity that has all of Owned_
+// sits at the same packed position in each of them, inside [0, Size()).
+template <typename... Owned_>
+class GroupHandler : public IGroupHandler {
+ public:
+  using size_type     = std::size_t;
+  using storage_tuple = std::tuple<ComponentStorage<Owned_>*...>;
+
+  explicit GroupHandler(storage_tuple storages_) : m_storages(storages_) {
+    auto* lead = std::get<0>(m_storages);
+    for (size_type i = 0; i < lead->Size(); ++i) {
+      OnEmplace(lead->Entities()[i]);
+    }
+  }
+
+  void OnEmplace(SECSY::Entity e_) noexcept override {
+    if (Contains(e_) || !HasAll(e_)) {
+      return;
+    }
+
+    std::apply(
+        [&](auto*... ptrs) {
+          (ptrs->SwapPositions(ptrs->Index(e_), m_size), ...);
+        },
+        m_storages);
+    ++m_size;
+  }
+
+  void OnRemove(SECSY::Entity e_) noexcept override {
+    if (!Contains(e_)) {
+      return;
+    }
+
+    --m_size;
+    std::apply(
+        [&](auto*... ptrs) {
+          (ptrs->SwapPositions(ptrs->Index(e_), m_size), ...);
+        },
+        m_storages);
+  }
+
+  bool Contains(SECSY::Entity e_) const noexcept {
+    return std::get<0>(m_storages)->Index(e_) < m_size;
+  }
+
+  size_type Size() const noexcept {
+    return m_size;
+  }
+
+  const storage_tuple& Storages() const noexcept {
+    return m_storages;
+  }
+
+ private:
+  bool HasAll(SECSY::Entity e_) const noexcept {
+    return std::apply([&](auto*... ptrs) { return (... && ptrs->Has(e_)); },
+                      m_storages);
+  }
+
+  storage_tuple m_storages;
+  size_type m_size{0};
+};
+
+template <typename... Owned_>
+class GroupIterator {
+ public:
+  using size_type     = std::size_t;
+  using group_tuple   = std::tuple<::SECSY::Entity, Owned_&...>;
+  using storage_tuple = std::tuple<ComponentStorage<Owned_>*...>;
+
+  GroupIterator(size_type index_, const storage_tuple& storages_)
+      : m_index(index_), m_storages(storages_) {}
+
+  // owned pools share positions, so this is a plain index into each array;
+  // every component handed out is touched
+  group_tuple operator*() const {
+    return std::apply(
+        [&](auto*... ptrs) {
+          (ptrs->Touch(m_index), ...);
+          return group_tuple(std::get<0>(m_storages)->Entities()[m_index],
+                             ptrs->At(m_index)...);
+        },
+        m_storages);
+  }
+
+  GroupIterator& operator++() {
+    ++m_index;
+    return *this;
+  }
+
+  bool operator==(const GroupIterator& other) const {
+    return m_index == other.m_index;
+  }
+  bool operator!=(const GroupIterator& other) const {
+    return !(*this == other);
+  }
+
+ private:
+  size_type m_index;
+  storage_tuple m_storages;
+};
+
+template <typename... Owned_>
+class Group {
+ public:
+  using size_type = std::size_t;
+  using iterator  = GroupIterator<Owned_...>;
+
+  explicit Group(GroupHandler<Owned_...>& handler_) : m_handler(&handler_) {}
+
+  iterator begin() const {
+    return iterator(0, m_handler->Storages());
+  }
+
+  iterator end() const {
+    return iterator(m_handler->Size(), m_handler->Storages());
+  }
+
+  size_type Size() const noexcept {
+    return m_handler->Size();
+  }
+
+  bool Contains(SECSY::Entity e_) const noexcept {
+    return m_handler->Contains(e_);
+  }
+
+  // calls func_(entity, owned...) over the shared prefix
+  template <typename Func_>
+  void Each(Func_&& func_) const {
+    const size_type size = m_handler->Size();
+    std::apply(
+        [&](auto* lead, auto*... ptrs) {
+          const ::SECSY::Entity* entities = lead->Entities();
+          for (size_type i = 0; i < size; ++i) {
+            lead->Touch(i);
+            (ptrs->Touch(i), ...);
+            func_(entities[i], lead->At(i), ptrs->At(i)...);
+          }
+        },
+        m_handler->Storages());
+  }
+
+ private:
+  GroupHandler<Owned_...>* m_handler;
+};
+
+}  // namespace Internal
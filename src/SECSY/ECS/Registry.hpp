@@ -1,207 +1,234 @@
 #pragma once
 
+#include <algorithm>
 #include <cstddef>
-#include <flat_map>
+#include <functional>
+#include <iterator>
 #include <memory>
-#include <queue>
+#include <memory_resource>
 #include <stdexcept>
 #include <tuple>
 #include <type_traits>
 #include <utility>
+#include <vector>
 
+#include "ComponentStorage.hpp"
+#include "Delta.hpp"
 #include "Entity.hpp"
-#include "../Core/SparseSet.hpp"
+#include "Group.hpp"
+#include "Signature.hpp"
+#include "View.hpp"
+#include "../Core/Signal.hpp"
 
-namespace Internal {
+namespace SECSY {
 
-using ComponentID =
-    std::uintptr_t;  // holds address of static variable as unique ID
+template <typename... Components_>
+class Snapshot;
 
-// TypeID implementation
-template <typename T_>
-ComponentID TypeID() noexcept {
-  static int dummy;  // every T_ will get a unique dummy static var
-  return reinterpret_cast<ComponentID>(&dummy);  // address ensures unique id
-}
+class Registry {
+ public:
+  // listeners get the registry and the entity whose component is affected
+  using signal_type = Signal<Registry&, Entity>;
 
-// Base class for all storages
-struct IComponentStorage {
-  virtual ~IComponentStorage()                   = default;
-  virtual ComponentID TypeID() const noexcept    = 0;
-  virtual void Remove(SECSY::Entity e_) noexcept = 0;
-};
+  Registry() : Registry(std::pmr::get_default_resource()) {}
 
-template <typename T_>
-class ComponentStorage : public IComponentStorage {
- public:
-  ComponentID TypeID() const noexcept override {
-    return ::Internal::TypeID<T_>();
-  }
-
-  template <typename... Args_>
-  T_& Emplace(SECSY::Entity e_, Args_&&... args_) {
-    auto [it, inserted] = m_data.try_emplace(e_, std::forward<Args_>(args_)...);
-    if (!inserted) {
-      if constexpr (std::is_nothrow_constructible_v<T_, Args_...> ||
-                    !std::is_nothrow_move_constructible_v<T_>) {
-        std::destroy_at(std::addressof(it->second));
-        std::construct_at(std::addressof(it->second),
-                          std::forward<Args_>(args_)...);
-      } else {
-        T_ tmp(std::forward<Args_>(args_)...);  // may throw; strong guarantee
-        std::destroy_at(std::addressof(it->second));
-        std::construct_at(std::addressof(it->second), std::move(tmp));
+  // entity slots, signatures and every component pool allocate from
+  // resource_, which must outlive the registry (or its next Clear)
+  explicit Registry(std::pmr::memory_resource* resource_)
+      : m_resource(resource_),
+        m_slots(resource_),
+        m_signatures(resource_) {}
+
+  Entity Create() {
+    Entity::id_type id;
+
+    if (m_free_head != 0) {
+      // pop the intrusive free list: a free slot holds the next free id and
+      // the version its entity will be recycled with
+      id = m_free_head;
+      RecordSlot(id, false);
+      m_free_head = m_slots[id].id;
+      m_slots[id] = Entity{id, m_slots[id].ver};
+    } else {
+      if (m_slots.size() > Entity::MAX_ID) {
+        throw std::length_error("entity ids exhausted");
       }
+      ReserveNullSlot();
+      id = static_cast<Entity::id_type>(m_slots.size());
+      RecordSlot(id, true);
+      m_slots.emplace_back(id, 1);
+      m_signatures.emplace_back();
     }
-    return it->second;
-  }
 
-  const T_& Get(SECSY::Entity e_) const {
-    auto it = m_data.find(e_);
-    if (it == m_data.end()) {
-      throw std::out_of_range("component not found for entity");
+    if (m_recording) [[unlikely]] {
+      m_recording->m_created.push_back(m_slots[id]);
     }
-    return it->second;
+    return m_slots[id];
   }
 
-  T_& Get(SECSY::Entity e_) {
-    return const_cast<T_&>(std::as_const(*this).Get(e_));
-  }
+  // fills [first_, last_) with new entities: recycled ids first, then fresh
+  // ids appended in one reservation
+  template <std::forward_iterator It_>
+  void Create(It_ first_, It_ last_) {
+    for (; first_ != last_ && m_free_head != 0; ++first_) {
+      *first_ = Create();
+    }
 
-  bool Has(SECSY::Entity e_) const noexcept {
-    return m_data.find(e_) != m_data.end();
-  }
+    auto count = static_cast<std::size_t>(std::distance(first_, last_));
+    if (count == 0) {
+      return;
+    }
+    ReserveNullSlot();
+    if (count > std::size_t{Entity::MAX_ID} + 1 - m_slots.size()) {
+      throw std::length_error("entity ids exhausted");
+    }
 
-  void Remove(SECSY::Entity e_) noexcept {
-    m_data.erase(e_);
+    m_slots.reserve(m_slots.size() + count);
+    m_signatures.resize(m_signatures.size() + count);
+    for (; first_ != last_; ++first_) {
+      auto id = static_cast<Entity::id_type>(m_slots.size());
+      RecordSlot(id, true);
+      *first_ = m_slots.emplace_back(id, 1);
+      if (m_recording) [[unlikely]] {
+        m_recording->m_created.push_back(*first_);
+      }
+    }
   }
 
- private:
-  std::flat_map<SECSY::Entity, T_> m_data;
-};
+  void Destroy(Entity e_) {
+    if (!IsAlive(e_)) {
+      return;
+    }
 
-template <typename... Components_>
-class ViewIterator {
- public:
-  using view_tuple = std::tuple<::SECSY::Entity, Components_&...>;
+    // Remove all components of entity, straight from a copy of its
+    // signature: destroy listeners may remove other components of e_, so
+    // each one is checked again before it fires
+    auto signature = m_signatures[e_.id];
+    signature.ForEach([&](std::size_t id) {
+      if (!IsAlive(e_) || !m_signatures[e_.id].Test(id)) {
+        return;
+      }
+      if (id < m_signals.size() && m_signals[id]) {
+        m_signals[id]->destroy.Publish(*this, e_);
+      }
+      m_storages[id]->Remove(e_);
+      m_signatures[e_.id].Reset(id);
+    });
+    if (!IsAlive(e_)) {
+      return;  // a listener destroyed it already
+    }
 
-  ViewIterator(::SECSY::Entity* current_,
-               ::SECSY::Entity* end_,
-               std::tuple<ComponentStorage<Components_>*...> storages_)
-      : m_current(current_), m_end(end_), m_storages(storages_) {
-    SkipNonMatching();
-  }
+    // whatever listeners added meanwhile goes without a signal
+    m_signatures[e_.id].ForEach(
+        [&](std::size_t id) { m_storages[id]->Remove(e_); });
+    m_signatures[e_.id].Clear();
 
-  view_tuple operator*() const {
-    return std::apply(
-        [&](auto*... ptrs) {
-          return view_tuple(*m_current, ptrs->Get(*m_current)...);
-        },
-        m_storages);
-  }
+    RecordSlot(e_.id, false);
+    if (m_recording) [[unlikely]] {
+      m_recording->m_destroyed.push_back(e_);
+    }
 
-  ViewIterator& operator++() {
-    ++m_current;
-    SkipNonMatching();
-    return *this;
+    // bump the version so stale handles stop matching, then push the slot
+    Entity::ver_type ver = (e_.ver == Entity::MAX_VERSION) ? 1 : e_.ver + 1;
+    m_slots[e_.id]       = Entity{m_free_head, ver};
+    m_free_head          = e_.id;
   }
 
-  bool operator==(const ViewIterator& other) const {
-    return m_current == other.m_current;
-  }
-  bool operator!=(const ViewIterator& other) const {
-    return !(*this == other);
+  // Drops every entity, component and group in one go. No signals fire and
+  // listeners stay connected. Component destructors still run, but pools of
+  // trivially destructible types are freed without visiting each element.
+  // Afterwards the registry holds no memory from its resource, so an Arena
+  // behind it can be released before the registry is used again. Handles
+  // from before the call must not be used: their ids get recycled. An
+  // active recording ends and its delta is emptied.
+  void Clear() noexcept {
+    if (auto* delta = m_recording) {
+      StopRecording();
+      delta->Clear();
+    }
+    m_storages.clear();
+    m_groups.clear();
+    decltype(m_slots)(m_resource).swap(m_slots);
+    decltype(m_signatures)(m_resource).swap(m_signatures);
+    m_free_head = 0;
   }
 
- private:
-  void SkipNonMatching() {
-    while (m_current != m_end && !Matches()) {
-      ++m_current;
+  // Records every change from now on into delta_ (emptied first), until
+  // StopRecording. Structural changes log what they replace; Get, views
+  // and groups log a copy of a component the first time they hand it out
+  // mutably, so a delta grows with what was touched, not with the pools
+  // iterated. Recording allocates as it goes; running out of memory while
+  // recording terminates. Owning groups cannot be recorded.
+  void Record(Delta& delta_) {
+    if (!m_groups.empty()) {
+      throw std::logic_error("cannot record a registry with owning groups");
     }
-  }
 
-  bool Matches() const {
-    return std::apply(
-        [&](auto*... ptrs) { return (... && ptrs->Has(*m_current)); },
-        m_storages);
+    StopRecording();
+    delta_.Clear();
+    delta_.m_journal.since = AdvanceTick();
+    m_recording            = &delta_;
+    for (auto& storage : m_storages) {
+      if (storage) {
+        storage->SetJournal(&delta_.m_journal);
+      }
+    }
   }
 
-  ::SECSY::Entity* m_current;
-  ::SECSY::Entity* m_end;
-  std::tuple<ComponentStorage<Components_>*...> m_storages;
-};
-
-template <typename... Components_>
-class View {
- public:
-  using iterator       = ViewIterator<Components_...>;
-  using const_iterator = const ViewIterator<Components_...>;
-  using view_tuple     = std::tuple<::SECSY::Entity, Components_&...>;
-
-  View(::SECSY::SparseSet<::SECSY::Entity>& entities_,
-       std::tuple<ComponentStorage<Components_>*...> storages_)
-      : m_entities(entities_), m_storages(storages_) {}
-
-  iterator begin() {
-    return iterator(
-        m_entities.Data(), m_entities.Data() + m_entities.Size(), m_storages);
+  void StopRecording() noexcept {
+    if (!m_recording) {
+      return;
+    }
+    m_recording = nullptr;
+    for (auto& storage : m_storages) {
+      if (storage) {
+        storage->SetJournal(nullptr);
+      }
+    }
   }
 
-  iterator end() {
-    return iterator(m_entities.Data() + m_entities.Size(),
-                    m_entities.Data() + m_entities.Size(),
-                    m_storages);
+  bool IsRecording() const noexcept {
+    return m_recording != nullptr;
   }
 
- private:
-  ::SECSY::SparseSet<::SECSY::Entity>& m_entities;
-  std::tuple<ComponentStorage<Components_>*...> m_storages;
-};
-
-}  // namespace Internal
-
-namespace SECSY {
-class Registry {
- public:
-  Entity Create() {
-    uint32_t id;
-    uint8_t ver;
-
-    if (m_free_entities.empty()) {
-      id  = m_next_id++;
-      ver = 1;
-    } else {
-      Entity e = m_free_entities.top();
-      m_free_entities.pop();
-      id  = e.id;
-      ver = (e.ver == 255) ? 1 : e.ver + 1;  // wrap to 1 on overflow, skip 0
-    }
-
-    Entity e{id, ver};
-    m_entities.Add(e);
-    return e;
-  }
+  // Reverts every change in delta_, newest first, and empties it. Pool
+  // order and change ticks come back too, so iteration after a rollback
+  // matches iteration before the changes. To go back over several
+  // recordings, roll them back newest first. Ends an active recording.
+  // No signals fire and the clock is not rewound.
+  void Rollback(Delta& delta_) {
+    StopRecording();
+
+    auto& journal = delta_.m_journal;
+    while (!journal.order.empty()) {
+      auto source = journal.order.back();
+      journal.order.pop_back();
+
+      if (source == ::Internal::Journal::REGISTRY) {
+        UndoSlot(delta_.m_slots.back());
+        delta_.m_slots.pop_back();
+        continue;
+      }
 
-  void Destroy(Entity e_) {
-    // Remove all components of entity
-    auto it = m_entity_to_component_ids.find(e_);
-    if (it != m_entity_to_component_ids.end()) {
-      for (auto comp_id : it->second) {
-        auto storage_it = m_storages.find(comp_id);
-        if (storage_it != m_storages.end()) {
-          storage_it->second->Remove(e_);
-        }
+      auto undone = journal.logs[source]->UndoLast(*m_storages[source]);
+      auto& signature = m_signatures[undone.entity.id];
+      if (undone.present) {
+        signature.Set(source);
+      } else {
+        signature.Reset(source);
       }
-      m_entity_to_component_ids.erase(it);
     }
+    delta_.Clear();
+  }
 
-    // Remove entity from live entities
-    m_entities.Remove(e_);
-    m_free_entities.push(e_);
+  std::pmr::memory_resource* Resource() const noexcept {
+    return m_resource;
   }
 
-  bool IsAlive(Entity e_) const {
-    return m_entities.Contains(e_);
+  // a single compare: the slot holds the live handle, or a free-list link
+  // whose id field never equals the slot's own id
+  bool IsAlive(Entity e_) const noexcept {
+    return e_.id < m_slots.size() && m_slots[e_.id] == e_;
   }
 
   template <typename T_, typename... Args_>
@@ -210,13 +237,52 @@ class Registry {
       throw std::out_of_range("Emplace() on non-alive entity");
     }
 
-    auto* storage = EnsureStorage<T_>();
-    auto& comp    = storage->Emplace(e_, std::forward<Args_>(args_)...);
+    auto* storage  = EnsureStorage<T_>();
+    auto* signals  = FindSignals<T_>();
+    bool replacing = signals && storage->Has(e_);
+    auto& comp     = storage->Emplace(e_, std::forward<Args_>(args_)...);
 
-    auto comp_id = ::Internal::TypeID<T_>();
-    m_entity_to_component_ids[e_].insert(comp_id);
+    m_signatures[e_.id].Set(::Internal::TypeID<T_>());
 
-    return comp;
+    if (!signals) {
+      return comp;
+    }
+    (replacing ? signals->update : signals->construct).Publish(*this, e_);
+    return storage->Get(e_);  // listeners may have moved it
+  }
+
+  // assigns T_(args_...) to the T_ e_ already has and signals the update
+  template <typename T_, typename... Args_>
+  T_& Replace(Entity e_, Args_&&... args_) {
+    return Patch<T_>(
+        e_, [&](T_& comp) { comp = T_(std::forward<Args_>(args_)...); });
+  }
+
+  // calls every func_(T_&) on the T_ of e_ in order, then signals the update
+  template <typename T_, typename... Func_>
+  T_& Patch(Entity e_, Func_&&... func_) {
+    T_& comp = Get<T_>(e_);
+    (std::forward<Func_>(func_)(comp), ...);
+
+    auto* signals = FindSignals<T_>();
+    if (!signals) {
+      return comp;
+    }
+    signals->update.Publish(*this, e_);
+    return FindStorage<T_>()->Get(e_);
+  }
+
+  // emplaces a copy of value_ for every entity in [first_, last_); all of
+  // them are checked before anything changes, and the pool grows only once
+  template <typename T_, std::forward_iterator It_>
+  void Insert(It_ first_, It_ last_, const T_& value_ = {}) {
+    InsertRange<T_>(first_, last_, value_);
+  }
+
+  // same, but the i-th entity gets the i-th element starting at from_
+  template <typename T_, std::forward_iterator It_, std::input_iterator From_>
+  void Insert(It_ first_, It_ last_, From_ from_) {
+    InsertRange<T_>(first_, last_, from_);
   }
 
   template <typename T_>
@@ -232,9 +298,13 @@ class Registry {
     return storage->Get(e);
   }
 
+  // mutable access counts as a change, see Changed<T_>
   template <typename T_>
   T_& Get(SECSY::Entity e_) {
-    return const_cast<T_&>(std::as_const(*this).template Get<T_>(e_));
+    T_& comp = const_cast<T_&>(std::as_const(*this).template Get<T_>(e_));
+    auto* storage = FindStorage<T_>();
+    storage->Touch(storage->Index(e_));
+    return comp;
   }
 
   template <typename T_>
@@ -244,79 +314,252 @@ class Registry {
     }
 
     auto id = ::Internal::TypeID<T_>();
-    auto it = m_storages.find(id);
-
-    if (it == m_storages.end()) {
-      return false;  // cannot have T_ component if no ComponentStorage exists
-    }
-
-    return static_cast<const ::Internal::ComponentStorage<T_>*>(
-               it->second.get())
-        ->Has(e_);
+    return id < ::Internal::Signature::CAPACITY && m_signatures[e_.id].Test(id);
   }
 
+  // OnDestroy listeners run first; if one throws, e_ keeps its T_
   template <typename T_>
-  void Remove(Entity e_) noexcept {
+  void Remove(Entity e_) {
     if (!IsAlive(e_)) {
       return;
     }
 
     if (auto* storage = FindStorage<T_>()) {
-      storage->Remove(e_);
-    }
-
-    auto comp_id = ::Internal::TypeID<T_>();
-    auto it      = m_entity_to_component_ids.find(e_);
-    if (it != m_entity_to_component_ids.end()) {
-      auto& comp_ids = it->second;
-      comp_ids.erase(comp_id);
-
-      if (comp_ids.empty()) {
-        m_entity_to_component_ids.erase(it);
+      if (auto* signals = FindSignals<T_>(); signals && storage->Has(e_)) {
+        signals->destroy.Publish(*this, e_);
       }
+      storage->Remove(e_);
+      m_signatures[e_.id].Reset(::Internal::TypeID<T_>());
     }
   }
 
+  // Components may be const-qualified: those are read-only in the view and
+  // do not count as changed, all others are stamped changed as they are
+  // visited
   template <typename... Components>
   auto View() {
-    auto storages = std::make_tuple(FindStorage<Components>()...);
+    auto storages =
+        std::make_tuple(FindStorage<std::remove_const_t<Components>>()...);
 
     if (std::apply([](auto*... ptrs) { return (... || (ptrs == nullptr)); },
                    storages)) {
       // Return an empty range
-      static SparseSet<Entity> empty;
-      return ::Internal::View<Components...>(empty, storages);
+      return ::Internal::View<Components...>();
+    }
+
+    ::Internal::Signature mask;
+    (mask.Set(::Internal::TypeID<std::remove_const_t<Components>>()), ...);
+
+    return ::Internal::View<Components...>(storages, m_signatures, mask);
+  }
+
+  // View restricted to entities whose T_ was added (Added<T_>) or changed
+  // (Changed<T_>) at or after filter_.since. T_ must be one of Components.
+  // With since at the current tick, T_'s list of slots stamped this tick
+  // drives when it is smaller than every pool; otherwise the smallest pool
+  // drives and T_'s ticks are tested per entity.
+  template <typename... Components, typename Filter_>
+  auto View(Filter_ filter_) {
+    auto view = View<Components...>();
+    view.SetFilter(filter_);
+    return view;
+  }
+
+  // Read-only views, on a const registry: every component must be
+  // const-qualified, so the view writes nothing, not even change ticks
+  template <typename... Components>
+    requires(std::is_const_v<Components> && ...)
+  auto View() const {
+    return const_cast<Registry&>(*this).View<Components...>();
+  }
+
+  template <typename... Components, typename Filter_>
+    requires(std::is_const_v<Components> && ...)
+  auto View(Filter_ filter_) const {
+    return const_cast<Registry&>(*this).View<Components...>(filter_);
+  }
+
+  // Sorts the T_ pool in place by compare_, over (const T_&, const T_&) or
+  // (Entity, Entity), so views driven by it visit entities in that order,
+  // e.g. Sort<Sprite>(by layer) ahead of drawing. Not stable; no signals
+  // fire and nothing counts as changed. Throws std::logic_error if a group
+  // owns the pool or while recording.
+  template <typename T_, typename Compare_>
+  void Sort(Compare_ compare_) {
+    if (auto* storage = SortableStorage<T_>()) {
+      storage->Sort(std::move(compare_));
+    }
+  }
+
+  // Sort by a key fixed at compile time, e.g. Sort<Sprite, &Sprite::layer>()
+  template <typename T_, auto Key_>
+  void Sort() {
+    Sort<T_>([](const T_& lhs_, const T_& rhs_) {
+      return std::invoke(Key_, lhs_) < std::invoke(Key_, rhs_);
+    });
+  }
+
+  // Reorders the To_ pool to follow the From_ pool: entities having both
+  // come first, in From_'s order, so a view over both walks the two pools
+  // sequentially. Same restrictions as Sort.
+  template <typename To_, typename From_>
+  void SortAs() {
+    auto* to   = SortableStorage<To_>();
+    auto* from = FindStorage<From_>();
+    if (to && from) {
+      to->SortAs(from->Entities(), from->Entities() + from->Size());
     }
+  }
+
+  // Per-type lifecycle signals. OnConstruct fires after a T_ is added,
+  // OnUpdate after Emplace over an existing T_, Replace or Patch, and
+  // OnDestroy before a T_ is removed, on Remove or Destroy. Changes made
+  // through references (Get, views, groups) are not signalled; see Changed<T_>
+  // for those. Listeners may read and write components but must not add or
+  // remove a T_ themselves; a destroy listener removing other components of
+  // an entity being destroyed is fine, those fire only once. Types nobody
+  // listens to pay a null check only.
+  template <typename T_>
+  signal_type& OnConstruct() {
+    return EnsureSignals<T_>().construct;
+  }
 
-    return ::Internal::View<Components...>(m_entities, storages);
+  template <typename T_>
+  signal_type& OnUpdate() {
+    return EnsureSignals<T_>().update;
+  }
+
+  template <typename T_>
+  signal_type& OnDestroy() {
+    return EnsureSignals<T_>().destroy;
+  }
+
+  // clock stamped on component changes
+  Tick CurrentTick() const noexcept {
+    return *m_clock;
+  }
+
+  // Moves the clock forward and returns the new tick. A system that
+  // consumes changes stores this after reading and passes it as `since`
+  // next time, so it sees every change made after its last read. Empties
+  // each pool's list of slots stamped at the previous tick.
+  Tick AdvanceTick() noexcept {
+    for (auto& storage : m_storages) {
+      if (storage) {
+        storage->ClearDirty();
+      }
+    }
+    return ++*m_clock;
+  }
+
+  // Owning group: the storages of Owned are reordered so that entities having
+  // all of them share a packed prefix, kept up to date on every structural
+  // change. A storage can be owned by at most one group.
+  template <typename... Owned>
+  auto Group() {
+    static_assert(sizeof...(Owned) > 0, "a group must own at least one type");
+    if (m_recording) {
+      throw std::logic_error("cannot create a group while recording");
+    }
+
+    using handler_type = ::Internal::GroupHandler<Owned...>;
+
+    auto storages = std::make_tuple(EnsureStorage<Owned>()...);
+    auto* owner   = std::get<0>(storages)->Owner();
+
+    if (owner) {
+      auto* handler = dynamic_cast<handler_type*>(owner);
+      if (!handler) {
+        throw std::logic_error("component storage owned by another group");
+      }
+      return ::Internal::Group<Owned...>(*handler);
+    }
+
+    if (std::apply([](auto*... ptrs) { return (... || ptrs->Owner()); },
+                   storages)) {
+      throw std::logic_error("component storage owned by another group");
+    }
+
+    auto handler = std::make_unique<handler_type>(storages);
+    auto& ref    = *handler;
+    m_groups.push_back(std::move(handler));
+    std::apply([&](auto*... ptrs) { (ptrs->SetOwner(&ref), ...); }, storages);
+
+    return ::Internal::Group<Owned...>(ref);
   }
 
  private:
-  using entity_storage = SparseSet<Entity>;
-  using entity_free_list =
-      std::priority_queue<Entity, std::vector<Entity>, std::greater<Entity>>;
+  template <typename... Components_>
+  friend class Snapshot;
+
+  // indexed by TypeID, null where a type has no storage in this registry
   using component_storage =
-      std::unordered_map<::Internal::ComponentID,
-                         std::unique_ptr<::Internal::IComponentStorage>>;
+      std::vector<std::unique_ptr<::Internal::IComponentStorage>>;
+
+  std::pmr::memory_resource* m_resource;
+
+  // slot per entity id; slot 0 is reserved so that Null is never alive.
+  // It is only allocated along with the first entity, which keeps an empty
+  // registry off its memory resource.
+  std::pmr::vector<Entity> m_slots;
+  Entity::id_type m_free_head{0};  // first free slot, 0 if none
+
+  // on the heap so storages keep a valid pointer when the registry moves
+  std::unique_ptr<Tick> m_clock{std::make_unique<Tick>(1)};
+
+  Delta* m_recording{nullptr};  // see Record
+
+  struct ComponentSignals {
+    signal_type construct;
+    signal_type update;
+    signal_type destroy;
+  };
 
-  entity_storage m_entities;
-  entity_free_list m_free_entities;
   component_storage m_storages;
 
-  Entity::id_type m_next_id{1};
+  // indexed by TypeID like m_storages, null until a type gets a listener
+  std::vector<std::unique_ptr<ComponentSignals>> m_signals;
+  std::vector<std::unique_ptr<::Internal::IGroupHandler>> m_groups;
+
+  // component signature per entity id, parallel to the entity slots
+  std::pmr::vector<::Internal::Signature> m_signatures;
+
+  void ReserveNullSlot() {
+    if (m_slots.empty()) {
+      RecordSlot(0, true);
+      m_slots.emplace_back(1, 0);
+      m_signatures.emplace_back();
+    }
+  }
 
-  std::unordered_map<Entity, std::unordered_set<::Internal::ComponentID>>
-      m_entity_to_component_ids;
+  // logs slot id_ as it is before a write, or as about to be appended
+  void RecordSlot(Entity::id_type id_, bool appended_) {
+    if (!m_recording) [[likely]] {
+      return;
+    }
+    m_recording->m_slots.push_back(Delta::SlotEntry{
+        id_, appended_ ? Entity{} : m_slots[id_], m_free_head, appended_});
+    m_recording->m_journal.order.push_back(::Internal::Journal::REGISTRY);
+  }
+
+  void UndoSlot(const Delta::SlotEntry& entry_) noexcept {
+    if (entry_.appended) {
+      m_slots.pop_back();
+      m_signatures.pop_back();
+    } else {
+      m_slots[entry_.id] = entry_.slot;
+    }
+    m_free_head = entry_.free_head;
+  }
 
   template <typename T_>
   const ::Internal::ComponentStorage<T_>* FindStorage() const noexcept {
     auto id = ::Internal::TypeID<T_>();
-    auto it = m_storages.find(id);
-    if (it == m_storages.end()) {
+    if (id >= m_storages.size()) {
       return nullptr;
     }
     return static_cast<const ::Internal::ComponentStorage<T_>*>(
-        it->second.get());
+        m_storages[id].get());
   }
 
   template <typename T_>
@@ -325,20 +568,99 @@ class Registry {
         std::as_const(*this).template FindStorage<T_>());
   }
 
+  // the T_ pool if it exists and may be reordered: a group keeps its own
+  // order, and a recording does not log reorders
+  template <typename T_>
+  ::Internal::ComponentStorage<T_>* SortableStorage() {
+    auto* storage = FindStorage<T_>();
+    if (storage && storage->Owner()) {
+      throw std::logic_error("cannot sort a storage owned by a group");
+    }
+    if (m_recording) {
+      throw std::logic_error("cannot sort while recording");
+    }
+    return storage;
+  }
+
+  template <typename T_>
+  ComponentSignals* FindSignals() const noexcept {
+    auto id = ::Internal::TypeID<T_>();
+    return id < m_signals.size() ? m_signals[id].get() : nullptr;
+  }
+
+  template <typename T_>
+  ComponentSignals& EnsureSignals() {
+    auto id = ::Internal::TypeID<T_>();
+    if (id >= m_signals.size()) {
+      m_signals.resize(id + 1);
+    }
+    if (!m_signals[id]) {
+      m_signals[id] = std::make_unique<ComponentSignals>();
+    }
+    return *m_signals[id];
+  }
+
+  template <typename T_, typename It_, typename Source_>
+  void InsertRange(It_ first_, It_ last_, Source_&& source_) {
+    if (!std::all_of(first_, last_, [&](Entity e) { return IsAlive(e); })) {
+      throw std::out_of_range("Insert() on non-alive entity");
+    }
+
+    auto* storage = EnsureStorage<T_>();
+    auto* signals = FindSignals<T_>();
+    auto id       = ::Internal::TypeID<T_>();
+    try {
+      storage->Insert(first_, last_, std::forward<Source_>(source_));
+    } catch (...) {
+      // keep the signatures of the entities that made it in
+      std::for_each(first_, last_, [&](Entity e) {
+        if (storage->Has(e) && !m_signatures[e.id].Test(id)) {
+          m_signatures[e.id].Set(id);
+          if (signals) {
+            signals->construct.Publish(*this, e);
+          }
+        }
+      });
+      throw;
+    }
+
+    if (!signals) {
+      std::for_each(
+          first_, last_, [&](Entity e) { m_signatures[e.id].Set(id); });
+      return;
+    }
+
+    // the signature bit still tells whether e had a T_ before the insert
+    std::for_each(first_, last_, [&](Entity e) {
+      auto& signature = m_signatures[e.id];
+      bool replaced   = signature.Test(id);
+      signature.Set(id);
+      (replaced ? signals->update : signals->construct).Publish(*this, e);
+    });
+  }
+
   // helper: find or create storage for T_
   template <typename T_>
   ::Internal::ComponentStorage<T_>* EnsureStorage() {
     auto id = ::Internal::TypeID<T_>();
-    auto it = m_storages.find(id);
-
-    if (it != m_storages.end()) {
-      return static_cast<::Internal::ComponentStorage<T_>*>(it->second.get());
+    if (id >= ::Internal::Signature::CAPACITY) {
+      throw std::length_error("too many component types, raise "
+                              "SECSY_MAX_COMPONENTS");
     }
 
-    // create and insert
-    auto uptr = std::make_unique<::Internal::ComponentStorage<T_>>();
-    auto [new_it, inserted] = m_storages.emplace(id, std::move(uptr));
-    return static_cast<::Internal::ComponentStorage<T_>*>(new_it->second.get());
+    if (id >= m_storages.size()) {
+      m_storages.resize(id + 1);
+    }
+    if (!m_storages[id]) {
+      auto storage =
+          std::make_unique<::Internal::ComponentStorage<T_>>(m_resource);
+      storage->SetClock(m_clock.get());
+      if (m_recording) {
+        storage->SetJournal(&m_recording->m_journal);
+      }
+      m_storages[id] = std::move(storage);
+    }
+    return static_cast<::Internal::ComponentStorage<T_>*>(m_storages[id].get());
   }
 };
 
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+
+#ifndef SECSY_MAX_COMPONENTS
+#define SECSY_MAX_COMPONENTS 64  // distinct component types per program
+#endif
+
+namespace Internal {
+
+// Fixed-size component bitmask, one bit per component TypeID. Kept as raw
+// words so set bits can be walked with countr_zero instead of testing each.
+class Signature {
+ public:
+  using size_type = std::size_t;
+  using word_type = std::uint64_t;
+
+  static constexpr size_type CAPACITY  = SECSY_MAX_COMPONENTS;
+  static constexpr size_type WORD_BITS = 64;
+
+  static constexpr size_type WORDS = (CAPACITY + WORD_BITS - 1) / WORD_BITS;
+
+  constexpr void Set(size_type index_) noexcept {
+    m_words[index_ / WORD_BITS] |= word_type{1} << (index_ % WORD_BITS);
+  }
+
+  constexpr void Reset(size_type index_) noexcept {
+    m_words[index_ / WORD_BITS] &= ~(word_type{1} << (index_ % WORD_BITS));
+  }
+
+  constexpr void Clear() noexcept {
+    m_words = {};
+  }
+
+  constexpr bool Test(size_type index_) const noexcept {
+    return (m_words[index_ / WORD_BITS] >> (index_ % WORD_BITS)) & 1u;
+  }
+
+  // true if every bit of mask_ is also set here
+  constexpr bool Contains(const Signature& mask_) const noexcept {
+    for (size_type i = 0; i < WORDS; ++i) {
+      if ((m_words[i] & mask_.m_words[i]) != mask_.m_words[i]) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  // true if any bit is set in both
+  constexpr bool Intersects(const Signature& other_) const noexcept {
+    for (size_type i = 0; i < WORDS; ++i) {
+      if ((m_words[i] & other_.m_words[i]) != 0) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  constexpr bool None() const noexcept {
+    for (word_type word : m_words) {
+      if (word != 0) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  // calls func_(index) for every set bit, lowest first
+  template <typename Func_>
+  constexpr void ForEach(Func_&& func_) const {
+    for (size_type i = 0; i < WORDS; ++i) {
+      for (word_type word = m_words[i]; word != 0; word &= word - 1) {
+        func_(i * WORD_BITS + static_cast<size_type>(std::countr_zero(word)));
+      }
+    }
+  }
+
+  constexpr bool operator==(const Signature&) const noexcept = default;
+
+ private:
+  std::array<word_type, WORDS> m_words{};
+};
+
+}  // namespace Internal
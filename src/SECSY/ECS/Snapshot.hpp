@@ -0,0 +1,357 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <ostream>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#include "ComponentStorage.hpp"
+#include "Entity.hpp"
+#include "Registry.hpp"
+#include "../Core/MappedFile.hpp"
+
+namespace SECSY {
+
+// Byte sink handed to SnapshotTraits<T>::Save
+class SnapshotWriter {
+ public:
+  explicit SnapshotWriter(std::ostream& out_) : m_out(&out_) {}
+
+  void WriteBytes(const void* data_, std::size_t size_) {
+    m_out->write(static_cast<const char*>(data_),
+                 static_cast<std::streamsize>(size_));
+    if (!*m_out) {
+      throw std::runtime_error("snapshot write failed");
+    }
+  }
+
+  template <typename T_>
+    requires std::is_trivially_copyable_v<T_>
+  void Write(const T_& value_) {
+    WriteBytes(&value_, sizeof(T_));
+  }
+
+  // length-prefixed
+  void WriteString(std::string_view text_) {
+    Write(static_cast<std::uint64_t>(text_.size()));
+    WriteBytes(text_.data(), text_.size());
+  }
+
+ private:
+  std::ostream* m_out;
+};
+
+// Byte source handed to SnapshotTraits<T>::Load; reads past the end throw
+class SnapshotReader {
+ public:
+  explicit SnapshotReader(std::span<const std::byte> bytes_)
+      : m_bytes(bytes_) {}
+
+  // the next size_ bytes, in place
+  const std::byte* Take(std::size_t size_) {
+    if (size_ > m_bytes.size() - m_offset) {
+      throw std::runtime_error("snapshot truncated");
+    }
+    const std::byte* data = m_bytes.data() + m_offset;
+    m_offset += size_;
+    return data;
+  }
+
+  void ReadBytes(void* data_, std::size_t size_) {
+    const std::byte* src = Take(size_);
+    if (size_ != 0) {
+      std::memcpy(data_, src, size_);
+    }
+  }
+
+  template <typename T_>
+    requires std::is_trivially_copyable_v<T_>
+  T_ Read() {
+    T_ value;
+    ReadBytes(&value, sizeof(T_));
+    return value;
+  }
+
+  std::string ReadString() {
+    auto size = Read<std::uint64_t>();
+    if (size > m_bytes.size() - m_offset) {
+      throw std::runtime_error("snapshot truncated");
+    }
+    std::string text(static_cast<std::size_t>(size), '\0');
+    ReadBytes(text.data(), text.size());
+    return text;
+  }
+
+  std::size_t Remaining() const noexcept {
+    return m_bytes.size() - m_offset;
+  }
+
+ private:
+  std::span<const std::byte> m_bytes;
+  std::size_t m_offset{0};
+};
+
+// Specialize for component types that cannot be copied bytewise:
+//
+//   template <>
+//   struct SECSY::SnapshotTraits<Sprite> {
+//     static void Save(SnapshotWriter& out_, const Sprite& sprite_);
+//     static Sprite Load(SnapshotReader& in_);
+//   };
+template <typename T_>
+struct SnapshotTraits;
+
+}  // namespace SECSY
+
+namespace Internal {
+
+// pools of these are written and read as one raw block
+template <typename T_>
+concept RawSnapshotComponent = std::is_trivially_copyable_v<T_> &&
+                               std::is_default_constructible_v<T_>;
+
+template <typename T_>
+concept HookedSnapshotComponent =
+    requires(SECSY::SnapshotWriter& out_, SECSY::SnapshotReader& in_,
+             const T_& value_) {
+      SECSY::SnapshotTraits<T_>::Save(out_, value_);
+      { SECSY::SnapshotTraits<T_>::Load(in_) } -> std::convertible_to<T_>;
+    };
+
+}  // namespace Internal
+
+namespace SECSY {
+
+// Binary save / load of a whole Registry. Components_ is the schema: every
+// listed type gets a section, in list order, and a loader must list the
+// same types in the same order. Types not listed are not saved.
+//
+// Layout, native byte order:
+//   "SECSYSNP", u32 format version, u32 sizeof(Entity), Entity{1, 2} as a
+//   layout probe, u64 slot count, u64 free-list head, u64 section count
+//   Entity slots[slot count]        (live handles and free-list links)
+//   per section: u32 index, u32 flags (1 = raw), u64 sizeof(T),
+//                u64 count, Entity owners[count], payload
+//
+// A raw payload is the packed pool copied as is, so loading it is a few
+// bulk copies plus rebuilding the sparse index; no per-entity Emplace.
+// Hooked payloads go through SnapshotTraits<T>. Tags have no payload.
+template <typename... Components_>
+class Snapshot {
+ public:
+  static constexpr std::uint32_t VERSION = 1;
+
+  static void Save(const Registry& registry_, std::ostream& out_) {
+    SnapshotWriter writer(out_);
+    writer.WriteBytes(MAGIC.data(), MAGIC.size());
+    writer.Write(VERSION);
+    writer.Write(static_cast<std::uint32_t>(sizeof(Entity)));
+    writer.Write(PROBE);
+
+    const auto& slots = registry_.m_slots;
+    writer.Write(static_cast<std::uint64_t>(slots.size()));
+    writer.Write(static_cast<std::uint64_t>(registry_.m_free_head));
+    writer.Write(static_cast<std::uint64_t>(sizeof...(Components_)));
+    writer.WriteBytes(slots.data(), slots.size() * sizeof(Entity));
+
+    std::uint32_t index = 0;
+    (SavePool<Components_>(registry_, writer, index++), ...);
+  }
+
+  // Replaces the contents of registry_ (see Registry::Clear) with the
+  // snapshot in bytes_. No signals fire; loaded components count as added
+  // at the current tick. On a malformed snapshot this throws and leaves
+  // registry_ empty.
+  static void Load(Registry& registry_, std::span<const std::byte> bytes_) {
+    registry_.Clear();
+    try {
+      SnapshotReader reader(bytes_);
+      LoadSlots(registry_, reader);
+
+      std::uint32_t index = 0;
+      (LoadPool<Components_>(registry_, reader, index++), ...);
+    } catch (...) {
+      registry_.Clear();
+      throw;
+    }
+  }
+
+  static void SaveFile(const Registry& registry_,
+                       const std::filesystem::path& path_) {
+    std::ofstream out(path_, std::ios::binary | std::ios::trunc);
+    if (!out) {
+      throw std::runtime_error("cannot open " + path_.string());
+    }
+    Save(registry_, out);
+  }
+
+  // maps the file and loads straight from the mapping
+  static void LoadFile(Registry& registry_,
+                       const std::filesystem::path& path_) {
+    MappedFile file(path_);
+    Load(registry_, file.Bytes());
+  }
+
+ private:
+  static constexpr std::array<char, 8> MAGIC = {
+      'S', 'E', 'C', 'S', 'Y', 'S', 'N', 'P'};
+  static constexpr Entity PROBE{1, 2};
+  static constexpr std::uint32_t RAW = 1;
+
+  template <typename T_>
+  static void SavePool(const Registry& registry_,
+                       SnapshotWriter& writer_,
+                       std::uint32_t index_) {
+    static_assert(::Internal::RawSnapshotComponent<T_> ||
+                      ::Internal::HookedSnapshotComponent<T_>,
+                  "component is not trivially copyable and default "
+                  "constructible, specialize SnapshotTraits for it");
+
+    const auto* storage = registry_.FindStorage<T_>();
+    std::uint64_t count = storage ? storage->Size() : 0;
+
+    writer_.Write(index_);
+    writer_.Write(::Internal::RawSnapshotComponent<T_> ? RAW : 0u);
+    writer_.Write(static_cast<std::uint64_t>(sizeof(T_)));
+    writer_.Write(count);
+    if (count == 0) {
+      return;
+    }
+
+    writer_.WriteBytes(storage->Entities(), count * sizeof(Entity));
+    if constexpr (::Internal::ComponentStorage<T_>::IS_TAG) {
+      return;
+    } else if constexpr (::Internal::RawSnapshotComponent<T_>) {
+      writer_.WriteBytes(storage->Data(), count * sizeof(T_));
+    } else {
+      for (std::uint64_t i = 0; i < count; ++i) {
+        SnapshotTraits<T_>::Save(writer_, storage->At(i));
+      }
+    }
+  }
+
+  static void LoadSlots(Registry& registry_, SnapshotReader& reader_) {
+    std::array<char, 8> magic;
+    reader_.ReadBytes(magic.data(), magic.size());
+    if (magic != MAGIC) {
+      throw std::runtime_error("not a SECSY snapshot");
+    }
+    if (reader_.Read<std::uint32_t>() != VERSION ||
+        reader_.Read<std::uint32_t>() != sizeof(Entity) ||
+        reader_.Read<Entity>() != PROBE) {
+      throw std::runtime_error("snapshot format or entity layout mismatch");
+    }
+
+    auto slots     = reader_.Read<std::uint64_t>();
+    auto free_head = reader_.Read<std::uint64_t>();
+    auto sections  = reader_.Read<std::uint64_t>();
+    if (slots > std::uint64_t{Entity::MAX_ID} + 1 ||
+        (free_head != 0 && free_head >= slots) ||
+        sections != sizeof...(Components_)) {
+      throw std::runtime_error("snapshot header is inconsistent");
+    }
+    if (slots > reader_.Remaining() / sizeof(Entity)) {
+      throw std::runtime_error("snapshot truncated");
+    }
+
+    auto count = static_cast<std::size_t>(slots);
+    auto head  = static_cast<Entity::id_type>(free_head);
+    registry_.m_slots.resize(count);
+    reader_.ReadBytes(registry_.m_slots.data(), count * sizeof(Entity));
+    CheckSlots(registry_.m_slots, head);
+
+    registry_.m_signatures.resize(count);
+    registry_.m_free_head = head;
+  }
+
+  // Throws unless slots_ is a table Registry could have built: slot 0 is
+  // the reserved null slot, the free list from free_head_ stays in range
+  // and visits no slot twice, and every other slot holds the live handle
+  // of its own id
+  static void CheckSlots(std::span<const Entity> slots_,
+                         Entity::id_type free_head_) {
+    if (slots_.empty()) {
+      return;
+    }
+    if (slots_[0] != Entity{1, 0}) {
+      throw std::runtime_error("snapshot null slot is corrupt");
+    }
+
+    std::vector<bool> free(slots_.size(), false);
+    for (Entity::id_type id = free_head_; id != 0; id = slots_[id].id) {
+      if (id >= slots_.size() || free[id]) {
+        throw std::runtime_error("snapshot free list is corrupt");
+      }
+      free[id] = true;
+    }
+
+    for (std::size_t id = 1; id < slots_.size(); ++id) {
+      if (!free[id] && (slots_[id].id != id || slots_[id].ver == 0)) {
+        throw std::runtime_error("snapshot has a corrupt entity slot");
+      }
+    }
+  }
+
+  template <typename T_>
+  static void LoadPool(Registry& registry_,
+                       SnapshotReader& reader_,
+                       std::uint32_t index_) {
+    using size_type     = typename ::Internal::ComponentStorage<T_>::size_type;
+    constexpr bool raw  = ::Internal::RawSnapshotComponent<T_>;
+    if (reader_.Read<std::uint32_t>() != index_ ||
+        reader_.Read<std::uint32_t>() != (raw ? RAW : 0u) ||
+        reader_.Read<std::uint64_t>() != sizeof(T_)) {
+      throw std::runtime_error("snapshot section does not match schema");
+    }
+
+    auto count = reader_.Read<std::uint64_t>();
+    if (count == 0) {
+      return;
+    }
+    if (count > reader_.Remaining() / sizeof(Entity)) {
+      throw std::runtime_error("snapshot truncated");
+    }
+
+    auto size          = static_cast<std::size_t>(count);
+    const auto* owners = reader_.Take(size * sizeof(Entity));
+    auto* storage      = registry_.EnsureStorage<T_>();
+    const auto id      = ::Internal::TypeID<T_>();
+
+    // every owner must be alive and listed once; the signature bit doubles
+    // as the duplicate check
+    for (std::size_t i = 0; i < size; ++i) {
+      Entity e;
+      std::memcpy(&e, owners + i * sizeof(Entity), sizeof(e));
+      if (!registry_.IsAlive(e) || registry_.m_signatures[e.id].Test(id)) {
+        throw std::runtime_error("snapshot section has a bad owner");
+      }
+      registry_.m_signatures[e.id].Set(id);
+    }
+
+    if constexpr (raw) {
+      const std::byte* values = nullptr;
+      if constexpr (!::Internal::ComponentStorage<T_>::IS_TAG) {
+        values = reader_.Take(size * sizeof(T_));
+      }
+      storage->AppendRaw(owners, static_cast<size_type>(size), values);
+    } else {
+      storage->Reserve(static_cast<size_type>(size));
+      for (std::size_t i = 0; i < size; ++i) {
+        Entity e;
+        std::memcpy(&e, owners + i * sizeof(Entity), sizeof(e));
+        storage->Emplace(e, SnapshotTraits<T_>::Load(reader_));
+      }
+    }
+  }
+};
+
+}  // namespace SECSY
@@ -1,7 +1,181 @@
 #pragma once
 
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "CommandBuffer.hpp"
+#include "ComponentStorage.hpp"
+#include "Registry.hpp"
+#include "Signature.hpp"
+#include "../Core/JobSystem.hpp"
+
 namespace SECSY {
 
-class Registry;  // Forward declaration
+// Component access lists for Scheduler::Add
+template <typename... Components_>
+struct Read {
+  static constexpr std::size_t SIZE = sizeof...(Components_);
+};
+
+template <typename... Components_>
+struct Write {
+  static constexpr std::size_t SIZE = sizeof...(Components_);
+};
+
+// Runs registered systems once per Run call. Each system declares the
+// component types it reads and writes; two systems conflict when one writes
+// a type the other reads or writes. Systems are put into stages: a system
+// goes one stage after the last earlier-registered system it conflicts with,
+// so conflicting systems keep their registration order and the systems of a
+// stage run concurrently on the JobSystem.
+//
+// Mutable access stamps change ticks (and logs while recording), which is
+// a write. A system that writes nothing is therefore handed a const
+// Registry&, and one that does write must reach the types it only reads
+// through const access too: View<const T_>, or Get on std::as_const.
+// Systems running in the same stage must not change the registry's
+// structure. A system also taking a CommandBuffer& gets its own buffer
+// instead, flushed after its stage in registration order.
+class Scheduler {
+ public:
+  using size_type = std::size_t;
+
+  explicit Scheduler(JobSystem& jobs_) : m_jobs(&jobs_) {}
+
+  template <typename Read_ = Read<>, typename Write_ = Write<>, typename Func_>
+  Scheduler& Add(std::string name_, Func_&& func_) {
+    System system;
+    system.name   = std::move(name_);
+    system.reads  = Mask(Read_{});
+    system.writes = Mask(Write_{});
+
+    if constexpr (Write_::SIZE == 0) {
+      system.run = Bind<const Registry&>(std::forward<Func_>(func_));
+    } else {
+      system.run = Bind<Registry&>(std::forward<Func_>(func_));
+    }
+
+    m_systems.push_back(std::move(system));
+    m_dirty = true;
+    return *this;
+  }
+
+  void Run(Registry& registry_) {
+    if (m_dirty) {
+      BuildStages();
+    }
+
+    for (const auto& stage : m_stages) {
+      m_jobs->ParallelFor(stage.size(), 1, [&](size_type begin_, size_type) {
+        System& system = m_systems[stage[begin_]];
+        system.run(registry_, system.commands);
+      });
+
+      for (size_type index : stage) {
+        m_systems[index].commands.Flush(registry_);
+      }
+    }
+  }
+
+  size_type StageCount() {
+    if (m_dirty) {
+      BuildStages();
+    }
+    return m_stages.size();
+  }
+
+  // stage index of the system registered under name_, or npos
+  size_type StageOf(const std::string& name_) {
+    if (m_dirty) {
+      BuildStages();
+    }
+    for (size_type i = 0; i < m_systems.size(); ++i) {
+      if (m_systems[i].name == name_) {
+        return m_systems[i].stage;
+      }
+    }
+    return npos;
+  }
+
+  static constexpr size_type npos = static_cast<size_type>(-1);
+
+ private:
+  struct System {
+    std::string name;
+    ::Internal::Signature reads;
+    ::Internal::Signature writes;
+    std::function<void(Registry&, CommandBuffer&)> run;
+    CommandBuffer commands;
+    size_type stage{0};
+  };
+
+  // adapts func_, taking Access_ and optionally a CommandBuffer&, to run
+  template <typename Access_, typename Func_>
+  static std::function<void(Registry&, CommandBuffer&)> Bind(Func_&& func_) {
+    return [func = std::forward<Func_>(func_)](
+               Registry& registry_, CommandBuffer& commands_) mutable {
+      if constexpr (std::is_invocable_v<decltype(func)&,
+                                        Access_,
+                                        CommandBuffer&>) {
+        func(static_cast<Access_>(registry_), commands_);
+      } else {
+        func(static_cast<Access_>(registry_));
+      }
+    };
+  }
+
+  template <template <typename...> typename List_, typename... Components_>
+  static ::Internal::Signature Mask(List_<Components_...>) {
+    ::Internal::Signature mask;
+    (mask.Set(CheckedTypeID<Components_>()), ...);
+    return mask;
+  }
+
+  template <typename T_>
+  static ::Internal::ComponentID CheckedTypeID() {
+    auto id = ::Internal::TypeID<T_>();
+    if (id >= ::Internal::Signature::CAPACITY) {
+      throw std::length_error("too many component types, raise "
+                              "SECSY_MAX_COMPONENTS");
+    }
+    return id;
+  }
+
+  static bool Conflicts(const System& lhs_, const System& rhs_) noexcept {
+    return lhs_.writes.Intersects(rhs_.reads) ||
+           lhs_.writes.Intersects(rhs_.writes) ||
+           rhs_.writes.Intersects(lhs_.reads);
+  }
+
+  void BuildStages() {
+    m_stages.clear();
+    for (size_type i = 0; i < m_systems.size(); ++i) {
+      size_type stage = 0;
+      for (size_type j = 0; j < i; ++j) {
+        if (Conflicts(m_systems[j], m_systems[i])) {
+          stage = std::max(stage, m_systems[j].stage + 1);
+        }
+      }
+
+      m_systems[i].stage = stage;
+      if (stage >= m_stages.size()) {
+        m_stages.resize(stage + 1);
+      }
+      m_stages[stage].push_back(i);
+    }
+    m_dirty = false;
+  }
+
+  JobSystem* m_jobs;
+  std::vector<System> m_systems;                // in registration order
+  std::vector<std::vector<size_type>> m_stages;  // system indices per stage
+  bool m_dirty{false};
+};
 
 }  // namespace SECSY
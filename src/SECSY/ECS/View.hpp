@@ -0,0 +1,327 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "ComponentStorage.hpp"
+#include "Entity.hpp"
+#include "Signature.hpp"
+#include "../Core/JobSystem.hpp"
+
+namespace SECSY {
+
+// View filters: only entities whose T_ was added / changed at or after
+// `since`, see Registry::AdvanceTick
+template <typename T_>
+struct Added {
+  Tick since;
+};
+
+template <typename T_>
+struct Changed {
+  Tick since;
+};
+
+}  // namespace SECSY
+
+namespace Internal {
+
+// Added/Changed filter: a predicate on the tick array of one of the view's
+// pools, tested per candidate, whether the candidates come from the driving
+// pool or from the filtered pool's dirty list
+struct TickFilter {
+  const ComponentTicks* ticks{nullptr};  // null when the view is unfiltered
+  bool added{false};
+  SECSY::Tick since{0};
+  std::size_t component{0};  // position of the filtered pool in the view
+
+  // index_ is the candidate's packed position in the filtered pool
+  bool Accepts(std::size_t index_) const noexcept {
+    return (added ? ticks[index_].added : ticks[index_].changed) >= since;
+  }
+};
+
+template <typename... Components_>
+class ViewIterator {
+ public:
+  using size_type      = std::size_t;
+  using view_tuple     = std::tuple<::SECSY::Entity, Components_&...>;
+  using storage_tuple  =
+      std::tuple<ComponentStorage<std::remove_const_t<Components_>>*...>;
+  using signature_list = std::pmr::vector<Signature>;
+
+  ViewIterator(const ::SECSY::Entity* entities_,
+               size_type index_,
+               size_type end_,
+               size_type driver_,
+               storage_tuple storages_,
+               const signature_list* signatures_,
+               Signature mask_,
+               TickFilter filter_)
+      : m_entities(entities_),
+        m_index(index_),
+        m_end(end_),
+        m_driver(driver_),
+        m_storages(storages_),
+        m_signatures(signatures_),
+        m_mask(mask_),
+        m_filter(filter_) {
+    SkipNonMatching();
+  }
+
+  // components were resolved while matching, no further lookups here
+  view_tuple operator*() const {
+    return std::apply(
+        [&](auto*... comps) {
+          return view_tuple(m_entities[m_index], *comps...);
+        },
+        m_components);
+  }
+
+  ViewIterator& operator++() {
+    ++m_index;
+    SkipNonMatching();
+    return *this;
+  }
+
+  bool operator==(const ViewIterator& other) const {
+    return m_index == other.m_index;
+  }
+  bool operator!=(const ViewIterator& other) const {
+    return !(*this == other);
+  }
+
+ private:
+  void SkipNonMatching() {
+    while (m_index != m_end &&
+           !Matches(std::index_sequence_for<Components_...>{})) {
+      ++m_index;
+    }
+  }
+
+  template <std::size_t... Is_>
+  bool Matches(std::index_sequence<Is_...> indices_) {
+    if constexpr (sizeof...(Components_) > 1) {
+      // one mask test rejects the entity before any pool is probed
+      const auto& signature = (*m_signatures)[m_entities[m_index].id];
+      if (!signature.Contains(m_mask)) {
+        return false;
+      }
+    }
+    // before any lookup, so a rejected entity is not stamped changed
+    if (m_filter.ticks && !m_filter.Accepts(FilteredIndex(indices_))) {
+      return false;
+    }
+    return (... && ((std::get<Is_>(m_components) = Lookup<Is_>()) != nullptr));
+  }
+
+  // the candidate's position in the filtered pool
+  template <std::size_t... Is_>
+  size_type FilteredIndex(std::index_sequence<Is_...>) const noexcept {
+    if (m_filter.component == m_driver) {
+      return m_index;
+    }
+    const ::SECSY::Entity e = m_entities[m_index];
+    size_type index         = 0;
+    ((Is_ == m_filter.component
+          ? void(index = std::get<Is_>(m_storages)->Index(e))
+          : void()),
+     ...);
+    return index;
+  }
+
+  // the driving pool is indexed directly, only the others are probed;
+  // a non-const component handed out is touched, see
+  // ComponentStorage::Touch. Tags are never probed: the signature mask (or
+  // driving their pool) already proves the entity has one, and there is no
+  // value to change.
+  template <std::size_t I_>
+  auto* Lookup() const noexcept {
+    using component = std::tuple_element_t<I_, std::tuple<Components_...>>;
+    using value     = std::remove_const_t<component>;
+
+    component* comp = nullptr;
+    if constexpr (ComponentStorage<value>::IS_TAG) {
+      comp = std::addressof(TagColumn<value>::Instance());
+    } else {
+      auto* storage   = std::get<I_>(m_storages);
+      size_type index = I_ == m_driver
+                            ? m_index
+                            : size_type{storage->Index(m_entities[m_index])};
+
+      if (index != size_type{storage->npos}) {
+        if constexpr (!std::is_const_v<component>) {
+          storage->Touch(index);
+        }
+        comp = std::addressof(storage->At(index));
+      }
+    }
+    return comp;
+  }
+
+  const ::SECSY::Entity* m_entities;
+  size_type m_index;
+  size_type m_end;
+  size_type m_driver;
+  storage_tuple m_storages;
+  const signature_list* m_signatures;
+  Signature m_mask;
+  TickFilter m_filter;
+  std::tuple<Components_*...> m_components{};
+};
+
+// Iterates the packed entities of the smallest participating pool (the
+// driver) and probes the remaining pools for each of them. An Added/Changed
+// filter is a tick test on each candidate, made before any component is
+// handed out. When it asks for nothing older than the current tick, the
+// filtered pool's dirty list (see ComponentStorage::Dirty) is a complete
+// candidate list; if it is shorter than the driver it drives instead and
+// every pool is probed, so the view costs what was changed rather than
+// what exists. Older `since` values fall back to testing the driver's
+// candidates.
+template <typename... Components_>
+class View {
+ public:
+  using size_type      = std::size_t;
+  using iterator       = ViewIterator<Components_...>;
+  using const_iterator = const ViewIterator<Components_...>;
+  using view_tuple     = std::tuple<::SECSY::Entity, Components_&...>;
+  using storage_tuple  =
+      std::tuple<ComponentStorage<std::remove_const_t<Components_>>*...>;
+  using signature_list = std::pmr::vector<Signature>;
+
+  // storages_ must all be non-null; mask_ holds the bits of Components_
+  View(storage_tuple storages_,
+       const signature_list& signatures_,
+       Signature mask_)
+      : m_storages(storages_), m_signatures(&signatures_), m_mask(mask_) {
+    std::apply(
+        [&](auto*... ptrs) {
+          const size_type sizes[]                 = {ptrs->Size()...};
+          const ::SECSY::Entity* const entities[] = {ptrs->Entities()...};
+
+          for (size_type i = 1; i < sizeof...(Components_); ++i) {
+            if (sizes[i] < sizes[m_driver]) {
+              m_driver = i;
+            }
+          }
+          m_size     = sizes[m_driver];
+          m_entities = entities[m_driver];
+        },
+        storages_);
+  }
+
+  // empty range, used when a storage does not exist yet
+  View() = default;
+
+  iterator begin() {
+    return MakeIterator(0, m_size);
+  }
+
+  iterator end() {
+    return MakeIterator(m_size, m_size);
+  }
+
+  template <typename T_>
+  void SetFilter(::SECSY::Added<T_> filter_) {
+    SetFilter<T_>(true, filter_.since);
+  }
+
+  template <typename T_>
+  void SetFilter(::SECSY::Changed<T_> filter_) {
+    SetFilter<T_>(false, filter_.since);
+  }
+
+  // upper bound on the number of matches: size of the driving pool
+  size_type SizeHint() const noexcept {
+    return m_size;
+  }
+
+  // calls func_(entity, components...) for every match
+  template <typename Func_>
+  void Each(Func_&& func_) {
+    EachIn(0, m_size, func_);
+  }
+
+  // Each, with the driving pool's packed range split into chunks of chunk_
+  // entries that run on jobs_. func_ is called concurrently and must only
+  // touch the entity it is given. Structural changes are not allowed until
+  // this returns; record them in a CommandBuffer per chunk instead.
+  template <typename Func_>
+  void ParallelEach(::SECSY::JobSystem& jobs_,
+                    Func_&& func_,
+                    size_type chunk_ = DEFAULT_CHUNK) {
+    jobs_.ParallelFor(m_size, chunk_, [&](size_type begin_, size_type end_) {
+      EachIn(begin_, end_, func_);
+    });
+  }
+
+  static constexpr size_type DEFAULT_CHUNK = 4096;
+
+ private:
+  iterator MakeIterator(size_type begin_, size_type end_) const {
+    return iterator(m_entities,
+                    begin_,
+                    end_,
+                    m_driver,
+                    m_storages,
+                    m_signatures,
+                    m_mask,
+                    m_filter);
+  }
+
+  template <typename Func_>
+  void EachIn(size_type begin_, size_type end_, Func_& func_) {
+    iterator last = MakeIterator(end_, end_);
+    for (iterator it = MakeIterator(begin_, end_); it != last; ++it) {
+      std::apply(func_, *it);
+    }
+  }
+
+  // position of T_ in Components_
+  template <typename T_>
+  static constexpr size_type IndexOf() noexcept {
+    constexpr bool matches[] = {
+        std::is_same_v<std::remove_const_t<Components_>, T_>...};
+    for (size_type i = 0; i < sizeof...(Components_); ++i) {
+      if (matches[i]) {
+        return i;
+      }
+    }
+    return sizeof...(Components_);
+  }
+
+  template <typename T_>
+  void SetFilter(bool added_, ::SECSY::Tick since_) {
+    constexpr size_type index = IndexOf<T_>();
+    static_assert(index < sizeof...(Components_),
+                  "filtered component must be part of the view");
+
+    auto* storage = std::get<index>(m_storages);
+    if (!storage) {
+      return;  // empty view
+    }
+    m_filter = TickFilter{storage->Ticks(), added_, since_, index};
+
+    if (since_ >= storage->DirtyTick() && storage->DirtySize() < m_size) {
+      m_entities = storage->Dirty();
+      m_size     = storage->DirtySize();
+      m_driver   = sizeof...(Components_);  // no pool is indexed directly
+    }
+  }
+
+  storage_tuple m_storages{};
+  const signature_list* m_signatures{nullptr};
+  Signature m_mask{};
+  TickFilter m_filter{};
+  const ::SECSY::Entity* m_entities{nullptr};
+  size_type m_size{0};
+  size_type m_driver{0};
+};
+
+}  // namespace Internal
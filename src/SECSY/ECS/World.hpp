@@ -0,0 +1,17 @@
+#pragma once
+
+#include "ArchetypeRegistry.hpp"
+#include "Registry.hpp"
+
+namespace SECSY {
+
+// Entity/component store used by the engine. Both layouts share the
+// Create, Destroy, Emplace, Insert, Get, Has, Remove and View surface;
+// Group, CommandBuffer and Scheduler work with the sparse-set Registry only.
+#ifdef SECSY_ARCHETYPE_STORAGE
+using World = ArchetypeRegistry;
+#else
+using World = Registry;
+#endif
+
+}  // namespace SECSY
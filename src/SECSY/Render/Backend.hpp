@@ -0,0 +1,36 @@
+#pragma once
+
+#include <concepts>
+#include <cstddef>
+#include <span>
+
+#include <raylib.h>
+
+namespace SECSY {
+
+// A sprite ready to draw: corners in render-target pixels, in the order
+// they are emitted, the normalized texture coordinates at two opposite
+// corners (the other two follow) and the tint.
+struct RenderQuad {
+  Vector2 top_left;
+  Vector2 bottom_left;
+  Vector2 bottom_right;
+  Vector2 top_right;
+  Vector2 uv_top_left;
+  Vector2 uv_bottom_right;
+  Color tint;
+};
+
+// What a Renderer draws through. BeginFrame and EndFrame bracket a frame;
+// in between, DrawBatch gets every run of quads sharing a texture, in draw
+// order, and returns how many draw calls it took.
+template <typename T_>
+concept RenderBackend = requires(T_& backend_,
+                                 unsigned int texture_,
+                                 std::span<const RenderQuad> quads_) {
+  backend_.BeginFrame();
+  { backend_.DrawBatch(texture_, quads_) } -> std::convertible_to<std::size_t>;
+  backend_.EndFrame();
+};
+
+}  // namespace SECSY
@@ -1,16 +1,29 @@
 #pragma once
 
 #include <cstdint>
+#include <type_traits>
 
-#include <raylib-cpp.hpp>  // or C
+#include <raylib.h>
+
+#include "TextureCache.hpp"
 
 namespace SECSY {
 
+struct Transform {
+  Vector2 position;  // top-left corner, in world units
+  float rotation;    // degrees, around position
+  Vector2 scale;
+};
+
 struct Sprite {
-  raylib::Texture2D texture;  // or C
-  raylib::Rectangle source;   // or C
-  raylib::Color tint;         // or C
-  std::int32_t layer;         // z-index
+  TextureHandle texture;  // from a TextureCache, which owns the texture
+  Rectangle source;       // texels to draw; a negative width/height flips
+  Color tint;
+  std::int32_t layer;  // z-index
 };
 
-}  // namespace SECSY
\ No newline at end of file
+// pools move, sort and snapshot sprites as raw bytes
+static_assert(std::is_trivially_copyable_v<Sprite>);
+static_assert(sizeof(Sprite) == 28);
+
+}  // namespace SECSY
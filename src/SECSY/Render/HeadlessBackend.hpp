@@ -0,0 +1,73 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "Backend.hpp"
+
+namespace SECSY {
+
+// Draws nothing and needs no window or GPU: keeps the batch stream of the
+// last frame in memory, so the draw pipeline can be timed on a build
+// server and checked in tests. Only raylib's plain structs are used.
+class HeadlessBackend {
+ public:
+  // quads [first, first + count) of Quads(), drawn with texture
+  struct Batch {
+    unsigned int texture;
+    std::size_t first;
+    std::size_t count;
+  };
+
+  HeadlessBackend(std::uint32_t internal_width, std::uint32_t internal_height)
+      : m_internal_width(internal_width), m_internal_height(internal_height) {}
+
+  void BeginFrame() {
+    m_batches.clear();
+    m_quads.clear();
+  }
+
+  std::size_t DrawBatch(unsigned int texture_,
+                        std::span<const RenderQuad> quads_) {
+    m_batches.push_back(Batch{texture_, m_quads.size(), quads_.size()});
+    m_quads.insert(m_quads.end(), quads_.begin(), quads_.end());
+    return 1;
+  }
+
+  void EndFrame() {
+    ++m_frames;
+  }
+
+  const std::vector<Batch>& Batches() const noexcept {
+    return m_batches;
+  }
+
+  const std::vector<RenderQuad>& Quads() const noexcept {
+    return m_quads;
+  }
+
+  // frames ended so far
+  std::size_t Frames() const noexcept {
+    return m_frames;
+  }
+
+  std::uint32_t Width() const noexcept {
+    return m_internal_width;
+  }
+
+  std::uint32_t Height() const noexcept {
+    return m_internal_height;
+  }
+
+ private:
+  std::vector<Batch> m_batches;
+  std::vector<RenderQuad> m_quads;
+  std::size_t m_frames{0};
+
+  std::uint32_t m_internal_width;
+  std::uint32_t m_internal_height;
+};
+
+}  // namespace SECSY
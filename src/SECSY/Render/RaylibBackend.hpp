@@ -0,0 +1,103 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+#include <raylib.h>
+#include <rlgl.h>
+
+#include "Backend.hpp"
+
+namespace SECSY {
+
+// Draws into an internal render texture through rlgl's vertex batching,
+// then scales that texture onto the window. Needs an open Window.
+class RaylibBackend {
+ public:
+  // prevent copying
+  RaylibBackend(const RaylibBackend&)            = delete;
+  RaylibBackend& operator=(const RaylibBackend&) = delete;
+
+  RaylibBackend(std::uint32_t internal_width, std::uint32_t internal_height) {
+    m_internal_width  = internal_width;
+    m_internal_height = internal_height;
+    m_target          = LoadRenderTexture(internal_width, internal_height);
+  }
+
+  ~RaylibBackend() {
+    UnloadRenderTexture(m_target);
+  }
+
+  void BeginFrame() {
+    BeginTextureMode(m_target);
+    ClearBackground(WHITE);  // Or whatever clear color
+  }
+
+  // one texture bind and one rlBegin for the run; rlgl draws the batch
+  // early if its vertex buffer fills up
+  std::size_t DrawBatch(unsigned int texture_,
+                        std::span<const RenderQuad> quads_) {
+    std::size_t draws = 1;
+    rlSetTexture(texture_);
+    rlBegin(RL_QUADS);
+    for (const RenderQuad& quad : quads_) {
+      if (rlCheckRenderBatchLimit(4)) {
+        ++draws;
+      }
+      rlColor4ub(quad.tint.r, quad.tint.g, quad.tint.b, quad.tint.a);
+      rlNormal3f(0.0f, 0.0f, 1.0f);
+
+      const Vector2 uv0 = quad.uv_top_left;
+      const Vector2 uv1 = quad.uv_bottom_right;
+      rlTexCoord2f(uv0.x, uv0.y);
+      rlVertex2f(quad.top_left.x, quad.top_left.y);
+      rlTexCoord2f(uv0.x, uv1.y);
+      rlVertex2f(quad.bottom_left.x, quad.bottom_left.y);
+      rlTexCoord2f(uv1.x, uv1.y);
+      rlVertex2f(quad.bottom_right.x, quad.bottom_right.y);
+      rlTexCoord2f(uv1.x, uv0.y);
+      rlVertex2f(quad.top_right.x, quad.top_right.y);
+    }
+    rlEnd();
+    return draws;
+  }
+
+  void EndFrame() {
+    rlSetTexture(0);
+    EndTextureMode();
+
+    // Now render the final texture scaled to the actual screen
+    ClearBackground(BLACK);  // Or whatever outer color
+
+    float windowWidth  = GetScreenWidth();
+    float windowHeight = GetScreenHeight();
+
+    float scale_x = windowWidth / static_cast<float>(m_internal_width);
+    float scale_y = windowHeight / static_cast<float>(m_internal_height);
+    float scale   = std::min(scale_x, scale_y);
+
+    float offset_x = (windowWidth - m_internal_width * scale) / 2.0f;
+    float offset_y = (windowHeight - m_internal_height * scale) / 2.0f;
+
+    DrawTexturePro(
+        m_target.texture,
+        {0, 0, (float)m_target.texture.width, -(float)m_target.texture.height},
+        {offset_x,
+         offset_y,
+         m_internal_width * scale,
+         m_internal_height * scale},
+        {0, 0},
+        0.0f,
+        WHITE);
+  }
+
+ private:
+  RenderTexture2D m_target;
+
+  std::uint32_t m_internal_width;
+  std::uint32_t m_internal_height;
+};
+
+}  // namespace SECSY
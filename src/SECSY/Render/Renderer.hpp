@@ -1,14 +1,21 @@
 #pragma once
 
-#include <algorithm>
+#include <cmath>
+#include <cstddef>
 #include <cstdint>
-#include <deque>
+#include <utility>
+#include <vector>
 
 #include <raylib.h>
 
+#include "../Core/RadixSort.hpp"
+#include "Backend.hpp"
+#include "RaylibBackend.hpp"
+
 // this is temporary, we'll fix this when the ECS is cooked
 struct SpriteDrawCommand {
   Texture2D texture;
+  Rectangle source;  // texels to draw; a negative width or height flips
   Vector2 position;
   float rotation;
   Vector2 scale;
@@ -18,83 +25,208 @@ struct SpriteDrawCommand {
 
 namespace SECSY {
 
-class Renderer {
+// what the last End drew
+struct RenderStats {
+  std::size_t sprites{0};
+  std::size_t batches{0};           // draw calls the sprites took
+  std::size_t texture_switches{0};  // texture changes between sprites
+};
+
+// What part of the world the render target shows: position is the world
+// point at the target's top-left corner, zoom the target pixels per world
+// unit
+struct RenderCamera {
+  Vector2 position{0.0f, 0.0f};
+  float zoom{1.0f};
+};
+
+// Collects sprites between Begin and End, then draws them through
+// Backend_ ordered by layer and grouped by texture. Renderer draws with
+// raylib; BasicRenderer<HeadlessBackend> runs the same pipeline without a
+// display.
+template <RenderBackend Backend_>
+class BasicRenderer {
  public:
   // prevent copying
-  Renderer(const Renderer&)            = delete;
-  Renderer& operator=(const Renderer&) = delete;
+  BasicRenderer(const BasicRenderer&)            = delete;
+  BasicRenderer& operator=(const BasicRenderer&) = delete;
 
-  Renderer(std::uint32_t internal_width, std::uint32_t internal_height) {
-    m_internal_width  = internal_width;
-    m_internal_height = internal_height;
-    m_target          = LoadRenderTexture(internal_width, internal_height);
-  }
+  BasicRenderer(std::uint32_t internal_width, std::uint32_t internal_height)
+      : m_backend(internal_width, internal_height),
+        m_internal_width(internal_width),
+        m_internal_height(internal_height) {}
 
   void Begin() {
-    BeginTextureMode(m_target);
-    ClearBackground(WHITE);  // Or whatever clear color
+    m_backend.BeginFrame();
   }
 
   void End() {
-    // Sort draw queue by layer (ascending)
-    std::sort(m_draw_queue.begin(),
-              m_draw_queue.end(),
-              [](const auto& a, const auto& b) { return a.layer < b.layer; });
-
-    for (const auto& cmd : m_draw_queue) {
-      DrawTexturePro(
-          cmd.texture,
-          {0, 0, (float)cmd.texture.width, (float)cmd.texture.height},
-          {cmd.position.x,
-           cmd.position.y,
-           cmd.texture.width * cmd.scale.x,
-           cmd.texture.height * cmd.scale.y},
-          {0, 0},
-          cmd.rotation,
-          cmd.tint);
+    // Order by layer, then texture; submission order breaks ties
+    m_sorter.Sort(m_keys, m_order);
+    DrawQueue();
+    m_backend.EndFrame();
+
+    m_draw_queue.clear();
+    m_keys.clear();
+    m_order.clear();
+  }
+
+  // cmd is in world units; everything submitted is drawn, so callers
+  // cull against Viewport() first (see RenderSystem)
+  void Submit(const SpriteDrawCommand& cmd) {
+    const float zoom = m_camera.zoom;
+    const Rectangle& src = cmd.source;
+
+    // same texture coordinates as DrawTexturePro, flips included
+    float u0 = src.x / cmd.texture.width;
+    float v0 = src.y / cmd.texture.height;
+    float u1 = (src.x + std::abs(src.width)) / cmd.texture.width;
+    float v1 = (src.y + std::abs(src.height)) / cmd.texture.height;
+    if (src.width < 0) {
+      std::swap(u0, u1);
+    }
+    if (src.height < 0) {
+      std::swap(v0, v1);
     }
 
-    EndTextureMode();
+    m_keys.push_back(SortKey(cmd.layer, cmd.texture.id));
+    m_order.push_back(static_cast<std::uint32_t>(m_draw_queue.size()));
+    m_draw_queue.push_back(
+        QueuedSprite{(cmd.position.x - m_camera.position.x) * zoom,
+                     (cmd.position.y - m_camera.position.y) * zoom,
+                     std::abs(src.width) * cmd.scale.x * zoom,
+                     std::abs(src.height) * cmd.scale.y * zoom,
+                     cmd.rotation,
+                     {u0, v0},
+                     {u1, v1},
+                     cmd.tint,
+                     cmd.texture.id});
+  }
 
-    m_draw_queue.clear();
+  void SetCamera(const RenderCamera& camera_) noexcept {
+    m_camera = camera_;
+  }
 
-    // Now render the final texture scaled to the actual screen
-    ClearBackground(BLACK);  // Or whatever outer color
-
-    float windowWidth  = GetScreenWidth();
-    float windowHeight = GetScreenHeight();
-
-    float scale_x = windowWidth / static_cast<float>(m_internal_width);
-    float scale_y = windowHeight / static_cast<float>(m_internal_height);
-    float scale   = std::min(scale_x, scale_y);
-
-    float offset_x = (windowWidth - m_internal_width * scale) / 2.0f;
-    float offset_y = (windowHeight - m_internal_height * scale) / 2.0f;
-
-    DrawTexturePro(
-        m_target.texture,
-        {0, 0, (float)m_target.texture.width, -(float)m_target.texture.height},
-        {offset_x,
-         offset_y,
-         m_internal_width * scale,
-         m_internal_height * scale},
-        {0, 0},
-        0.0f,
-        WHITE);
+  const RenderCamera& Camera() const noexcept {
+    return m_camera;
   }
 
-  void Submit(const SpriteDrawCommand& cmd) {
-    m_draw_queue.push_back(cmd);
+  // the world rectangle the camera shows
+  Rectangle Viewport() const noexcept {
+    return Rectangle{m_camera.position.x,
+                     m_camera.position.y,
+                     m_internal_width / m_camera.zoom,
+                     m_internal_height / m_camera.zoom};
+  }
+
+  // room for sprites_ submissions a frame; the queue keeps its capacity
+  // between frames either way
+  void Reserve(std::size_t sprites_) {
+    m_draw_queue.reserve(sprites_);
+    m_keys.reserve(sprites_);
+    m_order.reserve(sprites_);
+  }
+
+  const RenderStats& Stats() const noexcept {
+    return m_stats;
+  }
+
+  Backend_& Backend() noexcept {
+    return m_backend;
+  }
+
+  const Backend_& Backend() const noexcept {
+    return m_backend;
   }
 
  private:
-  RenderTexture2D m_target;
-  std::deque<SpriteDrawCommand> m_draw_queue;
+  // a submitted sprite, reduced to what drawing it takes
+  struct QueuedSprite {
+    float x, y;           // top-left corner
+    float width, height;  // on the render target
+    float rotation;       // degrees, around the top-left corner
+    Vector2 uv_top_left;
+    Vector2 uv_bottom_right;
+    Color tint;
+    unsigned int texture;
+  };
+
+  // layer in the high half, sign flipped so negative layers come first;
+  // texture id in the low half, so each layer groups its textures
+  static std::uint64_t SortKey(int layer_, unsigned int texture_) noexcept {
+    auto biased = static_cast<std::uint32_t>(layer_) ^ 0x80000000u;
+    return (std::uint64_t{biased} << 32) | texture_;
+  }
+
+  // hands the sorted queue to the backend one texture run at a time
+  void DrawQueue() {
+    m_stats         = RenderStats{};
+    m_stats.sprites = m_order.size();
+    m_quads.clear();
+    if (m_order.empty()) {
+      return;
+    }
+
+    unsigned int bound = m_draw_queue[m_order.front()].texture;
+    for (std::uint32_t index : m_order) {
+      const QueuedSprite& sprite = m_draw_queue[index];
+      if (sprite.texture != bound) {
+        m_stats.batches += m_backend.DrawBatch(bound, m_quads);
+        ++m_stats.texture_switches;
+        bound = sprite.texture;
+        m_quads.clear();
+      }
+      m_quads.push_back(MakeQuad(sprite));
+    }
+    m_stats.batches += m_backend.DrawBatch(bound, m_quads);
+  }
+
+  // the quad DrawTexturePro makes, origin {0, 0}
+  static RenderQuad MakeQuad(const QueuedSprite& sprite_) {
+    const float x = sprite_.x;
+    const float y = sprite_.y;
+    const float w = sprite_.width;
+    const float h = sprite_.height;
+
+    if (sprite_.rotation == 0.0f) {
+      return RenderQuad{{x, y},
+                        {x, y + h},
+                        {x + w, y + h},
+                        {x + w, y},
+                        sprite_.uv_top_left,
+                        sprite_.uv_bottom_right,
+                        sprite_.tint};
+    }
+
+    float sin_r = std::sin(sprite_.rotation * DEG2RAD);
+    float cos_r = std::cos(sprite_.rotation * DEG2RAD);
+    return RenderQuad{{x, y},
+                      {x - h * sin_r, y + h * cos_r},
+                      {x + w * cos_r - h * sin_r, y + w * sin_r + h * cos_r},
+                      {x + w * cos_r, y + w * sin_r},
+                      sprite_.uv_top_left,
+                      sprite_.uv_bottom_right,
+                      sprite_.tint};
+  }
+
+  Backend_ m_backend;
+  RenderCamera m_camera;
 
   std::uint32_t m_internal_width;
   std::uint32_t m_internal_height;
+
+  // packed per-frame queue; sorting moves keys and indices, not sprites
+  std::vector<QueuedSprite> m_draw_queue;
+  std::vector<std::uint64_t> m_keys;
+  std::vector<std::uint32_t> m_order;
+  RadixSorter m_sorter;
+
+  std::vector<RenderQuad> m_quads;  // the texture run being built
+  RenderStats m_stats;
 };
 
+using Renderer = BasicRenderer<RaylibBackend>;
+
 // note: apparently Begin() and End() should be part of Platform???
 
-}  // namespace SECSY
\ No newline at end of file
+}  // namespace SECSY
@@ -0,0 +1,177 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include <raylib.h>
+
+#include "../ECS/Entity.hpp"
+
+namespace SECSY {
+
+// Uniform grid over an unbounded plane: each entity is listed in every
+// cell its bounding rectangle overlaps, and only cells that ever held an
+// entity are allocated. Moving within the same cells only rewrites the
+// stored bounds. A query visits the cells under the queried area, so its
+// cost follows what is there, not the size of the world. Pick a cell size
+// around the size of a typical sprite or a few times larger.
+class SpatialGrid {
+ public:
+  using size_type = std::size_t;
+
+  static constexpr float DEFAULT_CELL_SIZE = 256.0f;
+
+  explicit SpatialGrid(float cell_size_ = DEFAULT_CELL_SIZE)
+      : m_cell_size(cell_size_), m_inv_cell_size(1.0f / cell_size_) {}
+
+  // inserts e_ with bounds_, or moves it there
+  void Update(Entity e_, Rectangle bounds_) {
+    if (e_.id >= m_items.size()) {
+      m_items.resize(e_.id + 1);
+    }
+
+    Item& item      = m_items[e_.id];
+    CellRange cells = CellsOf(bounds_);
+    if (item.entity == e_ && item.cells == cells) {
+      item.bounds = bounds_;
+      return;
+    }
+
+    if (item.entity != Entity::Null) {
+      Unlink(e_.id, item.cells);
+    } else {
+      ++m_size;
+    }
+    item = Item{e_, bounds_, cells};
+    Link(e_.id, cells);
+  }
+
+  // no-op if e_ is not in the grid
+  void Remove(Entity e_) noexcept {
+    if (!Contains(e_)) {
+      return;
+    }
+    Unlink(e_.id, m_items[e_.id].cells);
+    m_items[e_.id] = Item{};
+    --m_size;
+  }
+
+  bool Contains(Entity e_) const noexcept {
+    return e_.id < m_items.size() && m_items[e_.id].entity == e_;
+  }
+
+  // empties the grid; allocated cells are kept for reuse
+  void Clear() noexcept {
+    for (auto& [key, cell] : m_cells) {
+      cell.clear();
+    }
+    m_items.clear();
+    m_size = 0;
+  }
+
+  // appends every entity whose bounds overlap area_ to out_, each once
+  void Query(Rectangle area_, std::vector<Entity>& out_) const {
+    const CellRange range = CellsOf(area_);
+    const float right     = area_.x + area_.width;
+    const float bottom    = area_.y + area_.height;
+
+    for (std::int32_t y = range.min_y; y <= range.max_y; ++y) {
+      for (std::int32_t x = range.min_x; x <= range.max_x; ++x) {
+        auto found = m_cells.find(Key(x, y));
+        if (found == m_cells.end()) {
+          continue;
+        }
+
+        for (Entity::id_type id : found->second) {
+          const Item& item = m_items[id];
+          // an entity spanning several cells is reported by the first of
+          // them inside the queried range only
+          if (x != std::max(item.cells.min_x, range.min_x) ||
+              y != std::max(item.cells.min_y, range.min_y)) {
+            continue;
+          }
+
+          const Rectangle& b = item.bounds;
+          if (b.x < right && area_.x < b.x + b.width && b.y < bottom &&
+              area_.y < b.y + b.height) {
+            out_.push_back(item.entity);
+          }
+        }
+      }
+    }
+  }
+
+  size_type Size() const noexcept {
+    return m_size;
+  }
+
+  float CellSize() const noexcept {
+    return m_cell_size;
+  }
+
+ private:
+  // inclusive cell coordinates
+  struct CellRange {
+    std::int32_t min_x, min_y, max_x, max_y;
+
+    bool operator==(const CellRange&) const = default;
+  };
+
+  struct Item {
+    Entity entity{Entity::Null};
+    Rectangle bounds{};
+    CellRange cells{};
+  };
+
+  // far enough out that cell coordinates cannot overflow
+  static constexpr float LIMIT = 1 << 30;
+
+  std::int32_t CellOf(float coord_) const noexcept {
+    float cell = std::floor(coord_ * m_inv_cell_size);
+    return static_cast<std::int32_t>(std::clamp(cell, -LIMIT, LIMIT));
+  }
+
+  CellRange CellsOf(Rectangle bounds_) const noexcept {
+    return CellRange{CellOf(bounds_.x),
+                     CellOf(bounds_.y),
+                     CellOf(bounds_.x + bounds_.width),
+                     CellOf(bounds_.y + bounds_.height)};
+  }
+
+  static std::uint64_t Key(std::int32_t x_, std::int32_t y_) noexcept {
+    return (std::uint64_t{static_cast<std::uint32_t>(x_)} << 32) |
+           static_cast<std::uint32_t>(y_);
+  }
+
+  void Link(Entity::id_type id_, const CellRange& cells_) {
+    for (std::int32_t y = cells_.min_y; y <= cells_.max_y; ++y) {
+      for (std::int32_t x = cells_.min_x; x <= cells_.max_x; ++x) {
+        m_cells[Key(x, y)].push_back(id_);
+      }
+    }
+  }
+
+  void Unlink(Entity::id_type id_, const CellRange& cells_) noexcept {
+    for (std::int32_t y = cells_.min_y; y <= cells_.max_y; ++y) {
+      for (std::int32_t x = cells_.min_x; x <= cells_.max_x; ++x) {
+        auto& cell = m_cells.find(Key(x, y))->second;
+        auto at    = std::find(cell.begin(), cell.end(), id_);
+        *at        = cell.back();
+        cell.pop_back();
+      }
+    }
+  }
+
+  float m_cell_size;
+  float m_inv_cell_size;
+
+  std::vector<Item> m_items;  // by entity id
+  std::unordered_map<std::uint64_t, std::vector<Entity::id_type>> m_cells;
+  size_type m_size{0};
+};
+
+}  // namespace SECSY
@@ -1,20 +1,169 @@
 #pragma once
 
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <iterator>
+#include <vector>
+
+#include <raylib.h>
+
 #include "../ECS/Registry.hpp"
-#include "Renderer.hpp"
+#include "../ECS/View.hpp"
 #include "Components.hpp"
+#include "Renderer.hpp"
+#include "SpatialGrid.hpp"
+#include "TextureCache.hpp"
 
 namespace SECSY {
 
-void RenderSystem(Registry& reg) {
-  // auto view = reg.Each<Transform, Sprite>();
-  // for (auto entity : view) {
-  //   auto& tf     = view.get<Transform>(entity);
-  //   auto& sprite = view.get<Sprite>(entity);
-  //   Renderer::Submit(/*tf, sprite*/);
-  // }
+// Draws the entities having a Transform and a Sprite that the renderer's
+// camera can see. Their world bounds live in a SpatialGrid kept up to date
+// incrementally: each Run re-inserts only the entities whose Transform or
+// Sprite changed since the previous one (see Changed<T_>), destroyed ones
+// leave through OnDestroy, and only the grid cells under Viewport() are
+// visited. Sync keeps a copy of both components of each entity it
+// re-inserts, so drawing reads one array instead of probing both pools.
+// As long as nothing else advances the registry's tick between Runs, the
+// changes come from the pools' lists of slots stamped this tick, and the
+// cost per frame follows the visible sprites plus what changed, not the
+// size of the world.
+//
+// Registry::Clear, snapshot loads and rollbacks fire no signals; call
+// Rebuild after them.
+class RenderSystem {
+ public:
+  // prevent copying
+  RenderSystem(const RenderSystem&)            = delete;
+  RenderSystem& operator=(const RenderSystem&) = delete;
+
+  explicit RenderSystem(Registry& registry_,
+                        float cell_size_ = SpatialGrid::DEFAULT_CELL_SIZE)
+      : m_registry(&registry_), m_grid(cell_size_) {
+    auto remove    = [this](Registry&, Entity e_) { m_grid.Remove(e_); };
+    m_on_transform = registry_.OnDestroy<Transform>().Connect(remove);
+    m_on_sprite    = registry_.OnDestroy<Sprite>().Connect(remove);
+  }
+
+  ~RenderSystem() {
+    m_registry->OnDestroy<Transform>().Disconnect(m_on_transform);
+    m_registry->OnDestroy<Sprite>().Disconnect(m_on_sprite);
+  }
+
+  // Submits the visible sprites to renderer_, between its Begin and End,
+  // with their textures looked up in textures_. Sprites whose texture was
+  // released are skipped and counted, see Stale().
+  template <RenderBackend Backend_, TextureLoader Loader_>
+  void Run(BasicRenderer<Backend_>& renderer_,
+           const BasicTextureCache<Loader_>& textures_) {
+    Sync();
+
+    m_visible.clear();
+    m_grid.Query(renderer_.Viewport(), m_visible);
+
+    std::size_t drawn = 0;
+    m_stale           = 0;
+    for (std::size_t i = 0; i < m_visible.size(); ++i) {
+      const Entity e        = m_visible[i];
+      const auto& transform = m_drawables[e.id].transform;
+      const auto& sprite    = m_drawables[e.id].sprite;
+      const auto* texture   = textures_.TryGet(sprite.texture);
+      if (!texture) {
+        ++m_stale;
+        continue;
+      }
+      renderer_.Submit(SpriteDrawCommand{*texture,
+                                         sprite.source,
+                                         transform.position,
+                                         transform.rotation,
+                                         transform.scale,
+                                         sprite.tint,
+                                         sprite.layer});
+      m_visible[drawn++] = e;
+    }
+    m_visible.resize(drawn);
+  }
+
+  // re-inserts what changed since the last Sync; Run does this first
+  void Sync() {
+    Registry& registry = *m_registry;
+    auto update = [&](Entity e_, const Transform& tf_, const Sprite& sprite_) {
+      if (e_.id >= m_drawables.size()) {
+        m_drawables.resize(e_.id + 1);
+      }
+      m_grid.Update(e_, Bounds(tf_, sprite_));
+      m_drawables[e_.id] = Drawable{tf_, sprite_};
+    };
+    registry.View<const Transform, const Sprite>(Changed<Transform>{m_since})
+        .Each(update);
+    registry.View<const Transform, const Sprite>(Changed<Sprite>{m_since})
+        .Each(update);
+    m_since = registry.AdvanceTick();
+  }
+
+  // forgets the grid and inserts every sprite again
+  void Rebuild() {
+    m_grid.Clear();
+    m_since = 0;
+    Sync();
+  }
+
+  const SpatialGrid& Grid() const noexcept {
+    return m_grid;
+  }
+
+  // what the last Run submitted
+  const std::vector<Entity>& Visible() const noexcept {
+    return m_visible;
+  }
+
+  // sprites the last Run skipped for naming a released texture
+  std::size_t Stale() const noexcept {
+    return m_stale;
+  }
+
+  // world rectangle covered by the sprite drawn at tf_, rotation included
+  static Rectangle Bounds(const Transform& tf_, const Sprite& sprite_) {
+    const float w = std::abs(sprite_.source.width) * tf_.scale.x;
+    const float h = std::abs(sprite_.source.height) * tf_.scale.y;
+    const float x = tf_.position.x;
+    const float y = tf_.position.y;
+
+    if (tf_.rotation == 0.0f) {
+      return Rectangle{std::min(x, x + w),
+                       std::min(y, y + h),
+                       std::abs(w),
+                       std::abs(h)};
+    }
+
+    // corners relative to the top-left one, which the sprite rotates around
+    const float sin_r = std::sin(tf_.rotation * DEG2RAD);
+    const float cos_r = std::cos(tf_.rotation * DEG2RAD);
+    const float xs[]  = {0.0f, -h * sin_r, w * cos_r - h * sin_r, w * cos_r};
+    const float ys[]  = {0.0f, h * cos_r, w * sin_r + h * cos_r, w * sin_r};
+
+    auto [min_x, max_x] = std::minmax_element(std::begin(xs), std::end(xs));
+    auto [min_y, max_y] = std::minmax_element(std::begin(ys), std::end(ys));
+    return Rectangle{
+        x + *min_x, y + *min_y, *max_x - *min_x, *max_y - *min_y};
+  }
+
+ private:
+  // components as of the last Sync that re-inserted the entity
+  struct Drawable {
+    Transform transform;
+    Sprite sprite;
+  };
+
+  Registry* m_registry;
+  SpatialGrid m_grid;
+  std::vector<Drawable> m_drawables;  // by entity id, for those in m_grid
+  Tick m_since{0};  // a new system sees every sprite
+  std::vector<Entity> m_visible;
+  std::size_t m_stale{0};
 
-  // ^^ Commented until feature/ECS is completed
-}
+  Registry::signal_type::connection m_on_transform;
+  Registry::signal_type::connection m_on_sprite;
+};
 
-}  // namespace SECSY
\ No newline at end of file
+}  // namespace SECSY
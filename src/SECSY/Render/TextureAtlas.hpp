@@ -0,0 +1,194 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <numeric>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+#include <raylib.h>
+
+#include "../Core/SkylinePacker.hpp"
+#include "Components.hpp"
+#include "TextureCache.hpp"
+
+namespace SECSY {
+
+// Where an added image lives: the atlas page and its texels on that page
+struct AtlasRegion {
+  std::uint32_t page;
+  Rectangle source;
+};
+
+// Packs images into a few large textures (pages) so that sprites cut from
+// them share a texture and draw in one batch. Images go into the first
+// page with room, a new page is opened when none has any, and each image
+// is uploaded into its page as it is added, so content streamed in later
+// joins the pages already in use. Regions never move. Pages are adopted
+// by the TextureCache, so sprites name them by handle; the atlas releases
+// them when it goes, and must go before the cache. Needs an open Window.
+class TextureAtlas {
+ public:
+  using size_type = std::size_t;
+
+  static constexpr std::int32_t DEFAULT_PAGE_SIZE = 2048;
+
+  // prevent copying
+  TextureAtlas(const TextureAtlas&)            = delete;
+  TextureAtlas& operator=(const TextureAtlas&) = delete;
+
+  // every image is surrounded by padding_ texels repeating its edge, so
+  // bilinear filtering at a region's border samples the region's own
+  // colours, not a neighbour or blank texels
+  explicit TextureAtlas(TextureCache& cache_,
+                        std::int32_t page_size_ = DEFAULT_PAGE_SIZE,
+                        std::int32_t padding_   = 1)
+      : m_cache(&cache_), m_page_size(page_size_), m_padding(padding_) {}
+
+  ~TextureAtlas() {
+    for (const Sheet& page : m_pages) {
+      m_cache->Release(page.handle);
+    }
+  }
+
+  // Throws std::invalid_argument if image_ is empty or does not fit on a
+  // page, std::runtime_error if a new page cannot be created
+  AtlasRegion Add(const Image& image_) {
+    const std::int32_t width  = image_.width + 2 * m_padding;
+    const std::int32_t height = image_.height + 2 * m_padding;
+    if (image_.width <= 0 || image_.height <= 0 || width > m_page_size ||
+        height > m_page_size) {
+      throw std::invalid_argument("image empty or larger than an atlas page");
+    }
+
+    for (std::uint32_t page = 0; page < m_pages.size(); ++page) {
+      if (auto spot = m_pages[page].packer.Insert(width, height)) {
+        return Place(page, *spot, image_);
+      }
+    }
+    std::uint32_t page = OpenPage();
+    return Place(page, *m_pages[page].packer.Insert(width, height), image_);
+  }
+
+  // Adds images_ tallest first, which packs tighter than load order; the
+  // regions come back in the order of images_
+  std::vector<AtlasRegion> Add(std::span<const Image> images_) {
+    std::vector<std::size_t> order(images_.size());
+    std::iota(order.begin(), order.end(), std::size_t{0});
+    std::stable_sort(order.begin(), order.end(), [&](auto lhs_, auto rhs_) {
+      return images_[lhs_].height > images_[rhs_].height;
+    });
+
+    std::vector<AtlasRegion> regions(images_.size());
+    for (std::size_t index : order) {
+      regions[index] = Add(images_[index]);
+    }
+    return regions;
+  }
+
+  // points sprite_ at region_
+  void Assign(Sprite& sprite_, const AtlasRegion& region_) const {
+    sprite_.texture = m_pages.at(region_.page).handle;
+    sprite_.source  = region_.source;
+  }
+
+  TextureHandle Page(std::uint32_t page_) const {
+    return m_pages.at(page_).handle;
+  }
+
+  size_type PageCount() const noexcept {
+    return m_pages.size();
+  }
+
+  // share of page_ covered by images and their padding, 0 to 1
+  double Occupancy(std::uint32_t page_) const {
+    return m_pages.at(page_).packer.Occupancy();
+  }
+
+ private:
+  struct Sheet {
+    SkylinePacker packer;
+    TextureHandle handle;
+    Texture2D texture;  // as the cache holds it
+  };
+
+  std::uint32_t OpenPage() {
+    Image blank       = GenImageColor(m_page_size, m_page_size, BLANK);
+    Texture2D texture = LoadTextureFromImage(blank);
+    UnloadImage(blank);
+    if (texture.id == 0) {
+      throw std::runtime_error("failed to create atlas page");
+    }
+
+    m_pages.push_back(Sheet{SkylinePacker(m_page_size, m_page_size),
+                            m_cache->Adopt(texture),
+                            texture});
+    return static_cast<std::uint32_t>(m_pages.size() - 1);
+  }
+
+  // copies image_ into spot_ on page_; the region is inside the padding
+  AtlasRegion Place(std::uint32_t page_,
+                    const SkylinePacker::Rect& spot_,
+                    const Image& image_) {
+    Upload(m_pages[page_].texture, spot_, image_);
+    return AtlasRegion{page_,
+                       Rectangle{static_cast<float>(spot_.x + m_padding),
+                                 static_cast<float>(spot_.y + m_padding),
+                                 static_cast<float>(image_.width),
+                                 static_cast<float>(image_.height)}};
+  }
+
+  // Uploads image_ with its edges extruded into the padding, filling all
+  // of spot_. Pages are RGBA8, as GenImageColor makes them.
+  void Upload(const Texture2D& page_,
+              const SkylinePacker::Rect& spot_,
+              const Image& image_) const {
+    constexpr std::size_t TEXEL = 4;
+    const std::int32_t width    = image_.width + 2 * m_padding;
+    const std::int32_t height   = image_.height + 2 * m_padding;
+    std::vector<unsigned char> texels(static_cast<std::size_t>(width) *
+                                      static_cast<std::size_t>(height) *
+                                      TEXEL);
+
+    Image converted{};
+    const Image* rgba = &image_;
+    if (image_.format != PIXELFORMAT_UNCOMPRESSED_R8G8B8A8) {
+      converted = ImageCopy(image_);
+      ImageFormat(&converted, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8);
+      rgba = &converted;
+    }
+
+    // each padded texel takes the nearest texel of the image
+    const auto* src   = static_cast<const unsigned char*>(rgba->data);
+    const auto stride = static_cast<std::size_t>(image_.width) * TEXEL;
+    auto* dst         = texels.data();
+    for (std::int32_t y = 0; y < height; ++y) {
+      auto sy  = std::clamp(y - m_padding, 0, image_.height - 1);
+      auto row = src + static_cast<std::size_t>(sy) * stride;
+      for (std::int32_t x = 0; x < width; ++x, dst += TEXEL) {
+        auto sx = std::clamp(x - m_padding, 0, image_.width - 1);
+        std::memcpy(dst, row + static_cast<std::size_t>(sx) * TEXEL, TEXEL);
+      }
+    }
+    if (rgba == &converted) {
+      UnloadImage(converted);
+    }
+
+    UpdateTextureRec(page_,
+                     Rectangle{static_cast<float>(spot_.x),
+                               static_cast<float>(spot_.y),
+                               static_cast<float>(width),
+                               static_cast<float>(height)},
+                     texels.data());
+  }
+
+  TextureCache* m_cache;
+  std::int32_t m_page_size;
+  std::int32_t m_padding;
+  std::vector<Sheet> m_pages;
+};
+
+}  // namespace SECSY
@@ -0,0 +1,227 @@
+#pragma once
+
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <raylib.h>
+
+namespace SECSY {
+
+// Names a texture held by a TextureCache in one word: the slot index in
+// the low bits and the slot's generation above, so a handle to a released
+// texture does not resolve to whatever reuses its slot. The zero value is
+// Null, no texture.
+struct TextureHandle {
+  static constexpr std::uint32_t INDEX_BITS = 20;
+  static constexpr std::uint32_t INDEX_MASK = (1u << INDEX_BITS) - 1;
+  static constexpr std::uint32_t GEN_MASK   = ~0u >> INDEX_BITS;
+
+  std::uint32_t value{0};
+
+  constexpr std::uint32_t Index() const noexcept {
+    return value & INDEX_MASK;
+  }
+
+  constexpr std::uint32_t Generation() const noexcept {
+    return value >> INDEX_BITS;
+  }
+
+  constexpr bool IsValid() const noexcept {
+    return value != 0;
+  }
+
+  constexpr bool operator==(const TextureHandle&) const noexcept = default;
+
+  static const TextureHandle Null;
+};
+
+constexpr TextureHandle TextureHandle::Null = TextureHandle{};
+
+// What a TextureCache loads and unloads through. Load returns a texture
+// with id 0 on failure, as raylib's LoadTexture does.
+template <typename T_>
+concept TextureLoader =
+    requires(T_& loader_, const char* path_, Texture2D texture_) {
+      { loader_.Load(path_) } -> std::same_as<Texture2D>;
+      loader_.Unload(texture_);
+    };
+
+// Loads with raylib; needs an open Window
+struct RaylibTextureLoader {
+  Texture2D Load(const char* path_) {
+    return LoadTexture(path_);
+  }
+
+  void Unload(Texture2D texture_) {
+    UnloadTexture(texture_);
+  }
+};
+
+// Owns GPU textures and hands out TextureHandles to them. Loading a path
+// that is already loaded returns the same handle and counts one more
+// reference; Release drops one and unloads the texture with the last.
+// Handles are plain values: copying one, or a component holding one, does
+// not count as a reference, so whoever loads a texture releases it (a
+// level, an asset bundle), not each sprite drawing it. Whatever is still
+// loaded is unloaded with the cache.
+template <TextureLoader Loader_>
+class BasicTextureCache {
+ public:
+  using size_type = std::size_t;
+
+  // prevent copying
+  BasicTextureCache(const BasicTextureCache&)            = delete;
+  BasicTextureCache& operator=(const BasicTextureCache&) = delete;
+
+  explicit BasicTextureCache(Loader_ loader_ = Loader_{})
+      : m_loader(std::move(loader_)) {}
+
+  ~BasicTextureCache() {
+    for (const Slot& slot : m_slots) {
+      if (slot.refs > 0) {
+        m_loader.Unload(slot.texture);
+      }
+    }
+  }
+
+  // Throws std::runtime_error if the loader fails
+  TextureHandle Load(std::string_view path_) {
+    std::string path(path_);
+    if (auto found = m_paths.find(path); found != m_paths.end()) {
+      ++m_slots[found->second.Index()].refs;
+      return found->second;
+    }
+
+    Texture2D texture = m_loader.Load(path.c_str());
+    if (texture.id == 0) {
+      throw std::runtime_error("failed to load texture " + path);
+    }
+    TextureHandle handle = Insert(texture, path);
+    m_paths.emplace(std::move(path), handle);
+    return handle;
+  }
+
+  // takes over texture_, which was loaded some other way (a render
+  // target, an atlas page); it is unloaded through the loader all the same
+  TextureHandle Adopt(Texture2D texture_) {
+    return Insert(texture_, {});
+  }
+
+  // Throws std::out_of_range if handle_ was released
+  void Acquire(TextureHandle handle_) {
+    ++SlotOf(handle_).refs;
+  }
+
+  // no-op for a handle that was already released
+  void Release(TextureHandle handle_) {
+    if (!Contains(handle_)) {
+      return;
+    }
+
+    Slot& slot = m_slots[handle_.Index()];
+    if (--slot.refs > 0) {
+      return;
+    }
+    m_loader.Unload(slot.texture);
+    if (!slot.path.empty()) {
+      m_paths.erase(slot.path);
+    }
+
+    // a bumped generation turns every outstanding handle stale
+    slot.texture    = Texture2D{};
+    slot.path       = std::string{};
+    slot.generation = (slot.generation + 1) & TextureHandle::GEN_MASK;
+    if (slot.generation == 0) {
+      slot.generation = 1;
+    }
+    m_free.push_back(handle_.Index());
+    --m_size;
+  }
+
+  // Throws std::out_of_range if handle_ was released
+  const Texture2D& Get(TextureHandle handle_) const {
+    if (!Contains(handle_)) {
+      throw std::out_of_range("texture handle released");
+    }
+    return m_slots[handle_.Index()].texture;
+  }
+
+  // nullptr instead of throwing if handle_ was released
+  const Texture2D* TryGet(TextureHandle handle_) const noexcept {
+    return Contains(handle_) ? &m_slots[handle_.Index()].texture : nullptr;
+  }
+
+  bool Contains(TextureHandle handle_) const noexcept {
+    return handle_.Index() < m_slots.size() &&
+           m_slots[handle_.Index()].generation == handle_.Generation() &&
+           m_slots[handle_.Index()].refs > 0;
+  }
+
+  // references held on handle_, 0 once released
+  std::uint32_t RefCount(TextureHandle handle_) const noexcept {
+    return Contains(handle_) ? m_slots[handle_.Index()].refs : 0;
+  }
+
+  // textures loaded
+  size_type Size() const noexcept {
+    return m_size;
+  }
+
+  Loader_& Loader() noexcept {
+    return m_loader;
+  }
+
+ private:
+  struct Slot {
+    Texture2D texture{};
+    std::uint32_t generation{1};
+    std::uint32_t refs{0};
+    std::string path;  // empty when adopted
+  };
+
+  TextureHandle Insert(Texture2D texture_, std::string path_) {
+    std::uint32_t index;
+    if (!m_free.empty()) {
+      index = m_free.back();
+      m_free.pop_back();
+    } else {
+      if (m_slots.size() > TextureHandle::INDEX_MASK) {
+        throw std::length_error("texture handles exhausted");
+      }
+      index = static_cast<std::uint32_t>(m_slots.size());
+      m_slots.emplace_back();
+    }
+
+    Slot& slot   = m_slots[index];
+    slot.texture = texture_;
+    slot.refs    = 1;
+    slot.path    = std::move(path_);
+    ++m_size;
+    return TextureHandle{index |
+                         (slot.generation << TextureHandle::INDEX_BITS)};
+  }
+
+  Slot& SlotOf(TextureHandle handle_) {
+    if (!Contains(handle_)) {
+      throw std::out_of_range("texture handle released");
+    }
+    return m_slots[handle_.Index()];
+  }
+
+  Loader_ m_loader;
+  std::vector<Slot> m_slots;  // by handle index
+  std::vector<std::uint32_t> m_free;
+  std::unordered_map<std::string, TextureHandle> m_paths;
+  size_type m_size{0};
+};
+
+using TextureCache = BasicTextureCache<RaylibTextureLoader>;
+
+}  // namespace SECSY
@@ -1,10 +1,34 @@
 #pragma once
 
+#include "Core/Arena.hpp"
+#include "Core/Compiler.hpp"
+#include "Core/JobSystem.hpp"
+#include "Core/MappedFile.hpp"
+#include "Core/RadixSort.hpp"
+#include "Core/Signal.hpp"
+#include "Core/SkylinePacker.hpp"
 #include "Core/SparseSet.hpp"
 
+#include "ECS/Archetype.hpp"
+#include "ECS/ArchetypeRegistry.hpp"
+#include "ECS/CommandBuffer.hpp"
+#include "ECS/ComponentStorage.hpp"
+#include "ECS/Delta.hpp"
 #include "ECS/Entity.hpp"
+#include "ECS/Group.hpp"
 #include "ECS/Registry.hpp"
+#include "ECS/Signature.hpp"
+#include "ECS/Snapshot.hpp"
+#include "ECS/System.hpp"
+#include "ECS/View.hpp"
+#include "ECS/World.hpp"
 
+#include "Render/Backend.hpp"
 #include "Render/Components.hpp"
+#include "Render/HeadlessBackend.hpp"
+#include "Render/RaylibBackend.hpp"
 #include "Render/Renderer.hpp"
+#include "Render/SpatialGrid.hpp"
 #include "Render/System.hpp"
+#include "Render/TextureCache.hpp"
+#include "Render/TextureAtlas.hpp"
@@ -0,0 +1,116 @@
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <SECSY/Core/Arena.hpp>
+#include <SECSY/Core/SparseSet.hpp>
+#include <SECSY/ECS/Registry.hpp>
+
+namespace {
+
+// forwards to new/delete and counts what is outstanding
+class CountingResource : public std::pmr::memory_resource {
+ public:
+  std::size_t allocations{0};
+  std::size_t outstanding{0};
+
+ private:
+  void* do_allocate(std::size_t bytes, std::size_t align) override {
+    ++allocations;
+    outstanding += bytes;
+    return std::pmr::new_delete_resource()->allocate(bytes, align);
+  }
+
+  void do_deallocate(void* ptr,
+                     std::size_t bytes,
+                     std::size_t align) override {
+    outstanding -= bytes;
+    std::pmr::new_delete_resource()->deallocate(ptr, bytes, align);
+  }
+
+  bool do_is_equal(const memory_resource& other) const noexcept override {
+    return this == &other;
+  }
+};
+
+struct Position {
+  float x, y;
+};
+
+}  // namespace
+
+TEST(Arena_Basics, ReleaseReturnsEverythingUpstream) {
+  CountingResource upstream;
+  SECSY::Arena arena(4096, &upstream);
+
+  {
+    std::pmr::vector<int> values(arena.Resource());
+    for (int i = 0; i < 10'000; ++i) {
+      values.push_back(i);
+    }
+    EXPECT_GT(upstream.outstanding, 0u);
+  }
+
+  arena.Release();
+  EXPECT_EQ(upstream.outstanding, 0u);
+
+  // the arena is usable again after a release
+  std::pmr::vector<int> again(100, 1, arena.Resource());
+  EXPECT_EQ(again.back(), 1);
+}
+
+TEST(Arena_Basics, SparseSetAllocatesFromResource) {
+  CountingResource resource;
+  {
+    using set_type =
+        SECSY::SparseSet<std::size_t,
+                         std::uint32_t,
+                         64,
+                         std::pmr::polymorphic_allocator<std::size_t>>;
+    set_type set{set_type::allocator_type(&resource)};
+    for (std::size_t i = 0; i < 1000; i += 7) {
+      set.Add(i);
+    }
+    EXPECT_GT(resource.allocations, set.PageCount());
+    EXPECT_TRUE(set.Contains(994));
+  }
+  EXPECT_EQ(resource.outstanding, 0u);
+}
+
+TEST(Arena_Registry, RegistryAllocatesFromResource) {
+  CountingResource resource;
+  SECSY::Registry registry(&resource);
+  EXPECT_EQ(resource.allocations, 0u);  // empty registries allocate nothing
+
+  std::vector<SECSY::Entity> entities(1000);
+  registry.Create(entities.begin(), entities.end());
+  registry.Insert(entities.begin(), entities.end(), Position{1.0f, 2.0f});
+  EXPECT_GT(resource.outstanding, 1000 * sizeof(Position));
+
+  registry.Clear();
+  EXPECT_EQ(resource.outstanding, 0u);
+  EXPECT_FALSE(registry.IsAlive(entities[0]));
+}
+
+TEST(Arena_Registry, ClearAndReleaseReloadsWorld) {
+  SECSY::Arena arena;
+  SECSY::Registry registry(arena.Resource());
+
+  for (int level = 0; level < 3; ++level) {
+    std::vector<SECSY::Entity> entities(5000);
+    registry.Create(entities.begin(), entities.end());
+    registry.Insert(entities.begin(), entities.end(), Position{0.0f, 0.0f});
+    registry.Destroy(entities[10]);
+
+    std::size_t count = 0;
+    registry.View<const Position>().Each(
+        [&](SECSY::Entity, const Position&) { ++count; });
+    EXPECT_EQ(count, entities.size() - 1);
+
+    registry.Clear();
+    arena.Release();
+  }
+}
@@ -0,0 +1,60 @@
+#include <atomic>
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <SECSY/Core/JobSystem.hpp>
+
+using SECSY::JobSystem;
+
+TEST(JobSystem_ParallelFor, CoversEveryIndexOnce) {
+  JobSystem jobs(3);
+  std::vector<std::atomic<int>> hits(10'000);
+
+  jobs.ParallelFor(hits.size(), 64, [&](std::size_t begin, std::size_t end) {
+    for (std::size_t i = begin; i < end; ++i) {
+      hits[i].fetch_add(1, std::memory_order_relaxed);
+    }
+  });
+
+  for (const auto& hit : hits) {
+    EXPECT_EQ(hit.load(), 1);
+  }
+}
+
+TEST(JobSystem_ParallelFor, ChunksDoNotDependOnWorkerCount) {
+  auto chunk_sums = [](std::size_t workers) {
+    JobSystem jobs(workers);
+    std::vector<std::size_t> sums(16, 0);
+    jobs.ParallelFor(1000, 64, [&](std::size_t begin, std::size_t end) {
+      for (std::size_t i = begin; i < end; ++i) {
+        sums[begin / 64] += i;
+      }
+    });
+    return sums;
+  };
+
+  EXPECT_EQ(chunk_sums(0), chunk_sums(1));
+  EXPECT_EQ(chunk_sums(1), chunk_sums(7));
+}
+
+TEST(JobSystem_ParallelFor, RethrowsOnCaller) {
+  JobSystem jobs(2);
+  EXPECT_THROW(jobs.ParallelFor(100,
+                                10,
+                                [](std::size_t begin, std::size_t) {
+                                  if (begin == 50) {
+                                    throw std::runtime_error("chunk failed");
+                                  }
+                                }),
+               std::runtime_error);
+
+  // the pool stays usable afterwards
+  std::atomic<std::size_t> count{0};
+  jobs.ParallelFor(100, 10, [&](std::size_t begin, std::size_t end) {
+    count += end - begin;
+  });
+  EXPECT_EQ(count.load(), 100u);
+}
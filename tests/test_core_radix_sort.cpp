@@ -0,0 +1,57 @@
+#include <algorithm>
+#include <cstdint>
+#include <numeric>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <SECSY/Core/RadixSort.hpp>
+
+using SECSY::RadixSorter;
+
+TEST(RadixSort_Basics, MatchesStableSort) {
+  std::vector<std::uint64_t> keys;
+  std::uint64_t state = 12345;
+  for (int i = 0; i < 5000; ++i) {
+    state = state * 6364136223846793005ull + 1442695040888963407ull;
+    keys.push_back(state >> (i % 3 == 0 ? 60 : 8));  // many duplicates
+  }
+  std::vector<std::uint32_t> values(keys.size());
+  std::iota(values.begin(), values.end(), 0u);
+
+  std::vector<std::uint32_t> expected = values;
+  std::stable_sort(expected.begin(), expected.end(), [&](auto a, auto b) {
+    return keys[a] < keys[b];
+  });
+  auto original = keys;
+
+  RadixSorter sorter;
+  sorter.Sort(keys, values);
+
+  EXPECT_TRUE(std::is_sorted(keys.begin(), keys.end()));
+  EXPECT_EQ(values, expected);
+  for (std::size_t i = 0; i < keys.size(); ++i) {
+    EXPECT_EQ(keys[i], original[values[i]]);
+  }
+}
+
+TEST(RadixSort_Basics, OddPassCountAndReuse) {
+  RadixSorter sorter;
+
+  // only the lowest digit differs: one pass, result copied back
+  std::vector<std::uint64_t> keys = {0x503, 0x501, 0x502, 0x501};
+  std::vector<std::uint32_t> values = {0, 1, 2, 3};
+  sorter.Sort(keys, values);
+  EXPECT_EQ(keys, (std::vector<std::uint64_t>{0x501, 0x501, 0x502, 0x503}));
+  EXPECT_EQ(values, (std::vector<std::uint32_t>{1, 3, 2, 0}));
+
+  // layer in the high half, texture id in the low half
+  keys   = {(2ull << 32) | 7, (1ull << 32) | 9, (1ull << 32) | 7};
+  values = {0, 1, 2};
+  sorter.Sort(keys, values);
+  EXPECT_EQ(values, (std::vector<std::uint32_t>{2, 1, 0}));
+
+  keys.clear();
+  values.clear();
+  sorter.Sort(keys, values);  // empty input is fine
+}
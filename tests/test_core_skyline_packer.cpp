@@ -0,0 +1,80 @@
+#include <cstdint>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <SECSY/Core/SkylinePacker.hpp>
+
+using SECSY::SkylinePacker;
+
+namespace {
+
+bool Overlap(const SkylinePacker::Rect& a_, const SkylinePacker::Rect& b_) {
+  return a_.x < b_.x + b_.width && b_.x < a_.x + a_.width &&
+         a_.y < b_.y + b_.height && b_.y < a_.y + a_.height;
+}
+
+}  // namespace
+
+TEST(SkylinePacker_Basics, FillsExactlyWithEqualSquares) {
+  SkylinePacker packer(128, 64);
+  std::vector<SkylinePacker::Rect> placed;
+  for (int i = 0; i < 32; ++i) {
+    auto rect = packer.Insert(16, 16);
+    ASSERT_TRUE(rect.has_value()) << "square " << i;
+    placed.push_back(*rect);
+  }
+  EXPECT_DOUBLE_EQ(packer.Occupancy(), 1.0);
+  EXPECT_FALSE(packer.Insert(1, 1).has_value());
+
+  // bottom-left: the first row fills before the next one starts
+  EXPECT_EQ(placed[0], (SkylinePacker::Rect{0, 0, 16, 16}));
+  EXPECT_EQ(placed[7], (SkylinePacker::Rect{112, 0, 16, 16}));
+  EXPECT_EQ(placed[8], (SkylinePacker::Rect{0, 16, 16, 16}));
+
+  packer.Clear();
+  EXPECT_DOUBLE_EQ(packer.Occupancy(), 0.0);
+  EXPECT_EQ(packer.Insert(128, 64), (SkylinePacker::Rect{0, 0, 128, 64}));
+}
+
+TEST(SkylinePacker_Basics, MixedSizesStayInsideWithoutOverlap) {
+  SkylinePacker packer(512, 512);
+  std::vector<SkylinePacker::Rect> placed;
+
+  std::uint32_t state = 7;
+  for (int i = 0; i < 400; ++i) {
+    state = state * 1664525u + 1013904223u;
+    std::int32_t w = 4 + static_cast<std::int32_t>((state >> 8) % 60);
+    std::int32_t h = 4 + static_cast<std::int32_t>((state >> 20) % 60);
+    if (auto rect = packer.Insert(w, h)) {
+      EXPECT_EQ(rect->width, w);
+      EXPECT_EQ(rect->height, h);
+      placed.push_back(*rect);
+    }
+  }
+  ASSERT_GT(placed.size(), 100u);
+  EXPECT_GT(packer.Occupancy(), 0.6);
+
+  for (std::size_t i = 0; i < placed.size(); ++i) {
+    const auto& a = placed[i];
+    EXPECT_GE(a.x, 0);
+    EXPECT_GE(a.y, 0);
+    EXPECT_LE(a.x + a.width, 512);
+    EXPECT_LE(a.y + a.height, 512);
+    for (std::size_t j = i + 1; j < placed.size(); ++j) {
+      EXPECT_FALSE(Overlap(a, placed[j])) << i << " and " << j;
+    }
+  }
+}
+
+TEST(SkylinePacker_Basics, RejectsWhatCannotFit) {
+  SkylinePacker packer(64, 64);
+  EXPECT_FALSE(packer.Insert(65, 1).has_value());
+  EXPECT_FALSE(packer.Insert(1, 65).has_value());
+  EXPECT_FALSE(packer.Insert(0, 8).has_value());
+
+  // a tall column on the left leaves room only on the right
+  ASSERT_TRUE(packer.Insert(40, 64).has_value());
+  EXPECT_FALSE(packer.Insert(30, 8).has_value());
+  EXPECT_EQ(packer.Insert(24, 8), (SkylinePacker::Rect{40, 0, 24, 8}));
+}
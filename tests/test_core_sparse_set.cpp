@@ -0,0 +1,82 @@
+#include <cstdint>
+
+#include <gtest/gtest.h>
+
+#include <SECSY/Core/SparseSet.hpp>
+#include <SECSY/ECS/Entity.hpp>
+
+using SECSY::SparseSet;
+
+TEST(SparseSet_Basics, AddContainsRemove) {
+  SparseSet<std::size_t> set;
+  set.Add(3);
+  set.Add(7);
+  set.Add(3);  // duplicate is ignored
+
+  EXPECT_EQ(set.Size(), 2u);
+  EXPECT_TRUE(set.Contains(3));
+  EXPECT_TRUE(set.Contains(7));
+  EXPECT_FALSE(set.Contains(4));
+
+  set.Remove(3);
+  EXPECT_FALSE(set.Contains(3));
+  EXPECT_TRUE(set.Contains(7));
+  EXPECT_EQ(set[0], 7u);
+}
+
+TEST(SparseSet_Basics, SwapKeepsIndexInSync) {
+  SparseSet<std::size_t> set;
+  set.Add(1);
+  set.Add(2);
+  set.Swap(0, 1);
+
+  EXPECT_EQ(set[0], 2u);
+  EXPECT_EQ(set.Index(2), 0u);
+  EXPECT_EQ(set.Index(1), 1u);
+}
+
+TEST(SparseSet_Paging, OnlyTouchedPagesAreAllocated) {
+  SparseSet<std::size_t, std::uint32_t, 1024> set;
+  set.Add(5'000'000);
+  set.Add(10);
+
+  EXPECT_EQ(set.PageCount(), 2u);
+  EXPECT_TRUE(set.Contains(5'000'000));
+  EXPECT_FALSE(set.Contains(5'000'001));
+  EXPECT_FALSE(set.Contains(2'000'000));  // untouched page, no allocation
+  EXPECT_EQ(set.PageCount(), 2u);
+}
+
+TEST(SparseSet_Paging, CopyIsDeep) {
+  SparseSet<std::size_t, std::uint32_t, 64> set;
+  set.Add(100);
+
+  auto copy = set;
+  set.Remove(100);
+
+  EXPECT_FALSE(set.Contains(100));
+  EXPECT_TRUE(copy.Contains(100));
+}
+
+TEST(SparseSet_Entities, ContainsChecksTheFullHandle) {
+  SparseSet<SECSY::Entity, std::uint32_t> set;
+  set.Add(SECSY::Entity{4, 1});
+
+  EXPECT_TRUE(set.Contains(SECSY::Entity{4, 1}));
+  EXPECT_FALSE(set.Contains(SECSY::Entity{4, 2}));  // stale version
+}
+
+TEST(SparseSet_Entities, NewerVersionReplacesTheStaleOne) {
+  SparseSet<SECSY::Entity, std::uint32_t> set;
+  set.Add(SECSY::Entity{7, 1});
+  set.Add(SECSY::Entity{4, 1});
+  set.Add(SECSY::Entity{4, 2});  // same id, takes the old entry's place
+
+  EXPECT_EQ(set.Size(), 2u);
+  EXPECT_EQ(set[1], (SECSY::Entity{4, 2}));
+  EXPECT_FALSE(set.Contains(SECSY::Entity{4, 1}));
+
+  set.Remove(SECSY::Entity{4, 2});
+  EXPECT_EQ(set.Size(), 1u);
+  EXPECT_EQ(set[0], (SECSY::Entity{7, 1}));
+}
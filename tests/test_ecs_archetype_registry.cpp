@@ -0,0 +1,202 @@
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <unordered_set>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <SECSY/ECS/ArchetypeRegistry.hpp>
+#include <SECSY/ECS/Registry.hpp>
+
+namespace {
+
+struct Position {
+  int x, y;
+};
+
+struct Velocity {
+  float dx, dy;
+};
+
+struct Name {
+  std::string value;
+};
+
+// construction from an int throws on negative values
+struct Checked {
+  int value;
+
+  explicit Checked(int value_) : value(value_) {
+    if (value_ < 0) {
+      throw std::invalid_argument("negative");
+    }
+  }
+};
+
+}  // namespace
+
+class ArchetypeRegistryFixture : public ::testing::Test {
+ protected:
+  SECSY::ArchetypeRegistry reg;
+};
+
+TEST_F(ArchetypeRegistryFixture, EmplaceGetRemoveAcrossArchetypes) {
+  auto e = reg.Create();
+  reg.Emplace<Position>(e, 1, 2);
+  reg.Emplace<Name>(e, "hero");
+  reg.Emplace<Velocity>(e, 3.0f, 4.0f);
+
+  EXPECT_EQ(reg.Get<Position>(e).x, 1);
+  EXPECT_EQ(reg.Get<Name>(e).value, "hero");
+  EXPECT_FLOAT_EQ(reg.Get<Velocity>(e).dy, 4.0f);
+
+  reg.Remove<Position>(e);
+  EXPECT_FALSE(reg.Has<Position>(e));
+  EXPECT_THROW(reg.Get<Position>(e), std::out_of_range);
+  EXPECT_EQ(reg.Get<Name>(e).value, "hero");  // survived the move
+
+  reg.Emplace<Name>(e, "villain");  // overwrite in place
+  EXPECT_EQ(reg.Get<Name>(e).value, "villain");
+}
+
+TEST_F(ArchetypeRegistryFixture, SwapRemoveKeepsOtherRowsIntact) {
+  std::vector<SECSY::Entity> entities(100);
+  reg.Create(entities.begin(), entities.end());
+  for (int i = 0; i < 100; ++i) {
+    reg.Emplace<Position>(entities[i], i, -i);
+    reg.Emplace<Name>(entities[i], std::to_string(i));
+  }
+
+  for (int i = 0; i < 100; i += 3) {
+    reg.Destroy(entities[i]);
+  }
+  for (int i = 1; i < 100; i += 3) {
+    reg.Remove<Name>(entities[i]);
+  }
+
+  for (int i = 0; i < 100; ++i) {
+    EXPECT_EQ(reg.IsAlive(entities[i]), i % 3 != 0);
+    if (i % 3 == 0) {
+      continue;
+    }
+    EXPECT_EQ(reg.Get<Position>(entities[i]).x, i);
+    EXPECT_EQ(reg.Has<Name>(entities[i]), i % 3 == 2);
+    if (i % 3 == 2) {
+      EXPECT_EQ(reg.Get<Name>(entities[i]).value, std::to_string(i));
+    }
+  }
+}
+
+TEST_F(ArchetypeRegistryFixture, ViewSpansArchetypesAndChunks) {
+  // enough rows to need several chunks per archetype
+  std::vector<SECSY::Entity> entities(5000);
+  reg.Create(entities.begin(), entities.end());
+  reg.Insert(entities.begin(), entities.end(), Position{1, 1});
+  reg.Insert(entities.begin(), entities.begin() + 3000, Velocity{2, 0});
+  reg.Insert(entities.begin() + 1000, entities.begin() + 2000, Name{"x"});
+
+  auto view = reg.View<Position, Velocity>();
+  EXPECT_EQ(view.SizeHint(), 3000u);
+
+  std::unordered_set<SECSY::Entity> seen;
+  for (auto&& [entity, pos, vel] : view) {
+    pos.x += static_cast<int>(vel.dx);
+    seen.insert(entity);
+  }
+  EXPECT_EQ(seen.size(), 3000u);
+  EXPECT_EQ(reg.Get<Position>(entities[0]).x, 3);
+  EXPECT_EQ(reg.Get<Position>(entities[1500]).x, 3);
+  EXPECT_EQ(reg.Get<Position>(entities[4000]).x, 1);
+
+  size_t count = 0;
+  reg.View<Name>().Each([&](SECSY::Entity, Name& name) {
+    EXPECT_EQ(name.value, "x");
+    ++count;
+  });
+  EXPECT_EQ(count, 1000u);
+  EXPECT_EQ(reg.ArchetypeCount(), 4u);  // {}, P, PV, PVN
+}
+
+TEST_F(ArchetypeRegistryFixture, ThrowingOverwriteKeepsTheOldValue) {
+  auto e = reg.Create();
+  reg.Emplace<Checked>(e, 1);
+  EXPECT_THROW(reg.Emplace<Checked>(e, -1), std::invalid_argument);
+  EXPECT_EQ(reg.Get<Checked>(e).value, 1);
+}
+
+TEST_F(ArchetypeRegistryFixture, InsertAcrossSourceArchetypes) {
+  std::vector<SECSY::Entity> entities(300);
+  reg.Create(entities.begin(), entities.end());
+  // three source archetypes: {}, {Position}, and {Velocity} already there
+  reg.Insert(entities.begin() + 100, entities.begin() + 200, Position{1, 1});
+  reg.Insert(entities.begin() + 200, entities.end(), Velocity{1, 1});
+
+  std::vector<Velocity> values(300);
+  for (std::size_t i = 0; i < values.size(); ++i) {
+    values[i] = Velocity{static_cast<float>(i), 0};
+  }
+  reg.Insert<Velocity>(entities.begin(), entities.end(), values.begin());
+
+  for (std::size_t i = 0; i < entities.size(); ++i) {
+    EXPECT_FLOAT_EQ(reg.Get<Velocity>(entities[i]).dx, static_cast<float>(i));
+    EXPECT_EQ(reg.Has<Position>(entities[i]), i >= 100 && i < 200);
+  }
+  EXPECT_EQ(reg.View<const Velocity>().SizeHint(), 300u);
+}
+
+TEST_F(ArchetypeRegistryFixture, StaleHandlesAreRejected) {
+  auto e = reg.Create();
+  reg.Emplace<Position>(e, 1, 1);
+  reg.Destroy(e);
+  auto recycled = reg.Create();
+
+  EXPECT_EQ(recycled.id, e.id);
+  EXPECT_FALSE(reg.IsAlive(e));
+  EXPECT_FALSE(reg.Has<Position>(recycled));
+  EXPECT_THROW(reg.Emplace<Position>(e, 2, 2), std::out_of_range);
+}
+
+// code written against SECSY::World behaves the same on either layout
+template <typename Registry_>
+class WorldParity : public ::testing::Test {
+ protected:
+  Registry_ reg;
+};
+
+using WorldLayouts =
+    ::testing::Types<SECSY::Registry, SECSY::ArchetypeRegistry>;
+TYPED_TEST_SUITE(WorldParity, WorldLayouts);
+
+TYPED_TEST(WorldParity, ConstViewsVisitEveryMatch) {
+  auto& reg = this->reg;
+  std::vector<SECSY::Entity> entities(300);
+  reg.Create(entities.begin(), entities.end());
+  reg.Insert(entities.begin(), entities.end(), Position{2, 0});
+  reg.Insert(entities.begin(), entities.begin() + 100, Velocity{3, 0});
+
+  int sum = 0;
+  reg.template View<const Position>().Each(
+      [&](SECSY::Entity, const Position& pos) { sum += pos.x; });
+  EXPECT_EQ(sum, 600);
+
+  // mixed const and mutable
+  std::size_t count = 0;
+  reg.template View<Position, const Velocity>().Each(
+      [&](SECSY::Entity, Position& pos, const Velocity& vel) {
+        pos.x += static_cast<int>(vel.dx);
+        ++count;
+      });
+  EXPECT_EQ(count, 100u);
+  EXPECT_EQ(reg.template Get<Position>(entities[0]).x, 5);
+  EXPECT_EQ(reg.template Get<Position>(entities[200]).x, 2);
+
+  count = 0;
+  for (auto&& [entity, vel] : reg.template View<const Velocity>()) {
+    static_assert(std::is_const_v<std::remove_reference_t<decltype(vel)>>);
+    EXPECT_FLOAT_EQ(vel.dx, 3.0f);
+    ++count;
+  }
+  EXPECT_EQ(count, 100u);
+}
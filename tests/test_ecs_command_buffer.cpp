@@ -0,0 +1,200 @@
+#include <algorithm>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <SECSY/ECS/CommandBuffer.hpp>
+#include <SECSY/ECS/Registry.hpp>
+
+namespace {
+
+struct Health {
+  int hp;
+};
+
+struct Burning {
+  int ticks;
+};
+
+// moving a negative one throws, e.g. out of a command buffer on Flush
+struct Fragile {
+  int value;
+
+  explicit Fragile(int value_) : value(value_) {}
+  Fragile(Fragile&& other_) : value(other_.value) {
+    if (value < 0) {
+      throw std::runtime_error("fragile");
+    }
+  }
+  Fragile& operator=(Fragile&&) = default;
+};
+
+}  // namespace
+
+class CommandBufferFixture : public ::testing::Test {
+ protected:
+  SECSY::Registry reg;
+  SECSY::CommandBuffer cmd;
+};
+
+TEST_F(CommandBufferFixture, NothingHappensBeforeFlush) {
+  auto e = reg.Create();
+  cmd.Emplace<Health>(e, 10);
+  cmd.Create();
+  cmd.Destroy(e);
+
+  EXPECT_FALSE(cmd.Empty());
+  EXPECT_FALSE(reg.Has<Health>(e));
+  EXPECT_TRUE(reg.IsAlive(e));
+
+  cmd.Flush(reg);
+  EXPECT_TRUE(cmd.Empty());
+  EXPECT_FALSE(reg.IsAlive(e));
+}
+
+TEST_F(CommandBufferFixture, PendingHandlesResolveOnFlush) {
+  auto pending = cmd.Create();
+  EXPECT_FALSE(reg.IsAlive(pending));
+  cmd.Emplace<Health>(pending, 7);
+  cmd.Emplace<Burning>(pending, 3);
+
+  cmd.Flush(reg);
+
+  size_t count = 0;
+  for (auto&& [entity, health, burning] : reg.View<Health, Burning>()) {
+    EXPECT_TRUE(reg.IsAlive(entity));
+    EXPECT_EQ(health.hp, 7);
+    EXPECT_EQ(burning.ticks, 3);
+    ++count;
+  }
+  EXPECT_EQ(count, 1u);
+}
+
+TEST_F(CommandBufferFixture, StructuralChangesWhileIterating) {
+  std::vector<SECSY::Entity> entities(8);
+  reg.Create(entities.begin(), entities.end());
+  for (int i = 0; i < 8; ++i) {
+    reg.Emplace<Health>(entities[i], i);
+  }
+
+  for (auto&& [entity, health] : reg.View<Health>()) {
+    if (health.hp % 2 == 0) {
+      cmd.Destroy(entity);
+    } else {
+      cmd.Emplace<Burning>(entity, health.hp);
+      cmd.Remove<Health>(entity);
+    }
+  }
+  cmd.Flush(reg);
+
+  for (int i = 0; i < 8; ++i) {
+    EXPECT_EQ(reg.IsAlive(entities[i]), i % 2 == 1);
+    if (i % 2 == 1) {
+      EXPECT_FALSE(reg.Has<Health>(entities[i]));
+      EXPECT_EQ(reg.Get<Burning>(entities[i]).ticks, i);
+    }
+  }
+}
+
+TEST_F(CommandBufferFixture, CommandsOnDeadEntitiesAreSkipped) {
+  auto e = reg.Create();
+  cmd.Emplace<Health>(e, 1);
+  reg.Destroy(e);
+
+  EXPECT_NO_THROW(cmd.Flush(reg));
+  EXPECT_EQ(reg.View<Health>().SizeHint(), 0u);
+}
+
+TEST_F(CommandBufferFixture, RemoveAndEmplaceKeepTheirOrder) {
+  auto healed  = reg.Create();
+  auto dropped = reg.Create();
+  reg.Emplace<Health>(healed, 1);
+
+  cmd.Remove<Health>(healed);
+  cmd.Emplace<Health>(healed, 5);
+  cmd.Emplace<Health>(dropped, 3);
+  cmd.Remove<Health>(dropped);
+  // the same across a merge: other's commands come after ours
+  SECSY::CommandBuffer other;
+  cmd.Emplace<Burning>(dropped, 1);
+  other.Remove<Burning>(dropped);
+  other.Emplace<Burning>(dropped, 2);
+  cmd.Merge(other);
+  cmd.Flush(reg);
+
+  ASSERT_TRUE(reg.Has<Health>(healed));
+  EXPECT_EQ(reg.Get<Health>(healed).hp, 5);
+  EXPECT_FALSE(reg.Has<Health>(dropped));
+  ASSERT_TRUE(reg.Has<Burning>(dropped));
+  EXPECT_EQ(reg.Get<Burning>(dropped).ticks, 2);
+
+  // an emplace on a dead entity ahead of them must not shift the order
+  auto dead = reg.Create();
+  auto kept = reg.Create();
+  auto next = reg.Create();
+  reg.Destroy(dead);
+  reg.Emplace<Health>(kept, 1);
+  cmd.Emplace<Health>(dead, 0);
+  cmd.Remove<Health>(kept);
+  cmd.Emplace<Health>(kept, 7);
+  cmd.Emplace<Health>(next, 9);
+  cmd.Flush(reg);
+
+  ASSERT_TRUE(reg.Has<Health>(kept));
+  EXPECT_EQ(reg.Get<Health>(kept).hp, 7);
+  EXPECT_EQ(reg.Get<Health>(next).hp, 9);
+}
+
+TEST_F(CommandBufferFixture, FailedFlushLeavesTheBufferEmpty) {
+  auto e       = reg.Create();
+  auto pending = cmd.Create();
+  cmd.Emplace<Health>(pending, 1);
+  cmd.Emplace<Fragile>(e, -1);
+  cmd.Destroy(e);
+
+  EXPECT_THROW(cmd.Flush(reg), std::runtime_error);
+  EXPECT_TRUE(cmd.Empty());
+  EXPECT_TRUE(reg.IsAlive(e));  // the destroy was dropped
+  EXPECT_FALSE(reg.Has<Fragile>(e));
+
+  // the buffer is usable again
+  cmd.Emplace<Health>(e, 2);
+  cmd.Flush(reg);
+  EXPECT_EQ(reg.Get<Health>(e).hp, 2);
+}
+
+TEST_F(CommandBufferFixture, PerThreadBuffersMerge) {
+  constexpr int THREADS = 4;
+  constexpr int PER     = 100;
+
+  std::vector<SECSY::CommandBuffer> buffers(THREADS);
+  std::vector<std::thread> threads;
+  for (int t = 0; t < THREADS; ++t) {
+    threads.emplace_back([&buffers, t] {
+      for (int i = 0; i < PER; ++i) {
+        auto e = buffers[t].Create();
+        buffers[t].Emplace<Health>(e, t * PER + i);
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  for (auto& buffer : buffers) {
+    cmd.Merge(buffer);
+    EXPECT_TRUE(buffer.Empty());
+  }
+  cmd.Flush(reg);
+
+  std::vector<bool> seen(THREADS * PER, false);
+  for (auto&& [entity, health] : reg.View<Health>()) {
+    (void)entity;
+    ASSERT_LT(health.hp, THREADS * PER);
+    EXPECT_FALSE(seen[health.hp]);
+    seen[health.hp] = true;
+  }
+  EXPECT_EQ(std::count(seen.begin(), seen.end(), true), THREADS * PER);
+}
@@ -0,0 +1,221 @@
+#include <array>
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <SECSY/Core/JobSystem.hpp>
+
+#include <SECSY/ECS/Delta.hpp>
+#include <SECSY/ECS/Registry.hpp>
+
+namespace {
+
+struct Position {
+  int x, y;
+};
+
+struct Name {
+  std::string value;
+};
+
+struct Frozen {};
+
+// entity, position and name of every Position holder, in pool order
+using State = std::vector<std::pair<SECSY::Entity, int>>;
+
+State Capture(SECSY::Registry& registry_) {
+  State state;
+  registry_.View<const Position>().Each(
+      [&](SECSY::Entity e, const Position& pos) {
+        state.emplace_back(e, pos.x);
+      });
+  return state;
+}
+
+}  // namespace
+
+TEST(Delta_Rollback, RevertsStructuralAndValueChanges) {
+  SECSY::Registry registry;
+  std::vector<SECSY::Entity> entities(100);
+  registry.Create(entities.begin(), entities.end());
+  for (std::size_t i = 0; i < entities.size(); ++i) {
+    registry.Emplace<Position>(entities[i], static_cast<int>(i), 0);
+    registry.Emplace<Name>(entities[i], std::to_string(i));
+  }
+  registry.Destroy(entities[7]);  // leaves a free slot to recycle
+
+  const State before = Capture(registry);
+
+  SECSY::Delta delta;
+  registry.Record(delta);
+
+  registry.Get<Position>(entities[1]).x = 1000;
+  registry.Emplace<Position>(entities[2], -2, -2);
+  registry.Remove<Position>(entities[3]);
+  registry.Emplace<Frozen>(entities[4]);
+  registry.Destroy(entities[5]);
+  auto reused   = registry.Create();  // slot of entities[5]
+  auto recycled = registry.Create();  // slot of entities[7]
+  auto fresh    = registry.Create();
+  registry.Emplace<Position>(fresh, 42, 0);
+  registry.View<Position>().Each([](SECSY::Entity, Position& pos) {
+    pos.y += 1;
+  });
+
+  EXPECT_EQ(delta.Created().size(), 3u);
+  EXPECT_EQ(delta.Destroyed().size(), 1u);
+
+  registry.Rollback(delta);
+  EXPECT_TRUE(delta.Empty());
+  EXPECT_FALSE(registry.IsRecording());
+
+  EXPECT_EQ(Capture(registry), before);  // same values, same order
+  EXPECT_TRUE(registry.IsAlive(entities[5]));
+  EXPECT_EQ(registry.Get<Name>(entities[5]).value, "5");
+  EXPECT_TRUE(registry.Has<Position>(entities[3]));
+  EXPECT_FALSE(registry.Has<Frozen>(entities[4]));
+  EXPECT_FALSE(registry.IsAlive(reused));
+  EXPECT_FALSE(registry.IsAlive(recycled));
+  EXPECT_FALSE(registry.IsAlive(fresh));
+  registry.View<const Position>().Each(
+      [](SECSY::Entity, const Position& pos) { EXPECT_EQ(pos.y, 0); });
+
+  // the free list is back too: the same handles come out again
+  EXPECT_EQ(registry.Create(), recycled);
+  EXPECT_EQ(registry.Create(), fresh);
+}
+
+TEST(Delta_Rollback, SizeFollowsChangesNotWorld) {
+  SECSY::Registry registry;
+  std::vector<SECSY::Entity> entities(10'000);
+  registry.Create(entities.begin(), entities.end());
+  registry.Insert(entities.begin(), entities.end(), Position{0, 0});
+
+  SECSY::Delta delta;
+  registry.Record(delta);
+  for (int touch = 0; touch < 5; ++touch) {
+    registry.Get<Position>(entities[10]).x += 1;  // logged once
+  }
+  registry.Get<Position>(entities[20]).x = 1;
+  registry.StopRecording();
+
+  EXPECT_EQ(delta.Size(), 2u);
+
+  registry.Rollback(delta);
+  EXPECT_EQ(registry.Get<Position>(entities[10]).x, 0);
+  EXPECT_EQ(registry.Get<Position>(entities[20]).x, 0);
+}
+
+TEST(Delta_Rollback, FramesRollBackNewestFirst) {
+  SECSY::Registry registry;
+  auto e = registry.Create();
+  registry.Emplace<Position>(e, 0, 0);
+
+  std::array<SECSY::Delta, 3> frames;
+  for (int frame = 0; frame < 3; ++frame) {
+    registry.Record(frames[frame]);
+    registry.Get<Position>(e).x = frame + 1;
+    registry.Emplace<Position>(registry.Create(), frame, frame);
+  }
+  registry.StopRecording();
+  EXPECT_EQ(Capture(registry).size(), 4u);
+
+  registry.Rollback(frames[2]);
+  EXPECT_EQ(registry.Get<Position>(e).x, 2);
+  registry.Rollback(frames[1]);
+  registry.Rollback(frames[0]);
+  EXPECT_EQ(registry.Get<Position>(e).x, 0);
+  EXPECT_EQ(Capture(registry).size(), 1u);
+}
+
+TEST(Delta_Rollback, ViewsLogEachComponentOnce) {
+  SECSY::Registry registry;
+  std::vector<SECSY::Entity> entities(100);
+  registry.Create(entities.begin(), entities.end());
+  registry.Insert(entities.begin(), entities.end(), Position{1, 1});
+
+  SECSY::Delta delta;
+  registry.Record(delta);
+  for (int frame = 0; frame < 3; ++frame) {
+    registry.View<const Position>().Each([](SECSY::Entity, const Position&) {});
+    EXPECT_EQ(delta.Size(), frame == 0 ? 0u : entities.size());
+    registry.View<Position>().Each(
+        [](SECSY::Entity, Position& pos) { pos.x += 1; });
+    EXPECT_EQ(delta.Size(), entities.size());
+  }
+
+  registry.Rollback(delta);
+  registry.View<const Position>().Each(
+      [](SECSY::Entity, const Position& pos) { EXPECT_EQ(pos.x, 1); });
+}
+
+TEST(Delta_Rollback, SparseViewsLogOnlyWhatTheyVisit) {
+  SECSY::Registry registry;
+  std::vector<SECSY::Entity> entities(1000);
+  registry.Create(entities.begin(), entities.end());
+  registry.Insert(entities.begin(), entities.end(), Position{1, 1});
+  for (std::size_t i = 0; i < 10; ++i) {
+    registry.Emplace<Frozen>(entities[i * 97]);
+  }
+
+  SECSY::Delta delta;
+  registry.Record(delta);
+  // driven by the ten Frozen, so only their Positions are handed out
+  registry.View<Position, const Frozen>().Each(
+      [](SECSY::Entity, Position& pos, const Frozen&) { pos.x = 7; });
+  EXPECT_EQ(delta.Size(), 10u);
+
+  // a view made before the recording logs too
+  SECSY::Delta later;
+  auto view = registry.View<Position>();
+  registry.Record(later);
+  for (auto [e, pos] : view) {
+    pos.y = 3;
+  }
+  EXPECT_EQ(later.Size(), entities.size());
+
+  registry.Rollback(later);
+  registry.Rollback(delta);
+  registry.View<const Position>().Each([](SECSY::Entity, const Position& pos) {
+    EXPECT_EQ(pos.x, 1);
+    EXPECT_EQ(pos.y, 1);
+  });
+}
+
+TEST(Delta_Rollback, ParallelGetsAreLogged) {
+  SECSY::Registry registry;
+  std::vector<SECSY::Entity> entities(5000);
+  registry.Create(entities.begin(), entities.end());
+  registry.Insert(entities.begin(), entities.end(), Position{1, 1});
+
+  SECSY::Delta delta;
+  registry.Record(delta);
+  SECSY::JobSystem jobs(3);
+  registry.View<const Position>().ParallelEach(
+      jobs,
+      [&](SECSY::Entity e, const Position&) {
+        registry.Get<Position>(e).x = 9;
+      },
+      64);
+  EXPECT_EQ(delta.Size(), entities.size());
+
+  registry.Rollback(delta);
+  registry.View<const Position>().Each(
+      [](SECSY::Entity, const Position& pos) { EXPECT_EQ(pos.x, 1); });
+}
+
+TEST(Delta_Rollback, GroupsCannotBeRecorded) {
+  SECSY::Registry registry;
+  SECSY::Delta delta;
+
+  registry.Record(delta);
+  EXPECT_THROW(registry.Group<Position>(), std::logic_error);
+  registry.StopRecording();
+
+  registry.Group<Position>();
+  EXPECT_THROW(registry.Record(delta), std::logic_error);
+}
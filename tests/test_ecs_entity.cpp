@@ -53,4 +53,34 @@ TEST_F(EntityTest, LessOperatorWorks) {
   Entity e2{2, 1};
 
   EXPECT_TRUE(std::less<Entity>{}(e1, e2));
-}
\ No newline at end of file
+}
+
+TEST_F(EntityTest, HandlePacksIntoSingleWord) {
+  EXPECT_EQ(sizeof(Entity), sizeof(std::uint32_t));
+  EXPECT_EQ(sizeof(BasicEntity<EntityTraits24x8>), sizeof(std::uint32_t));
+  EXPECT_EQ(sizeof(BasicEntity<EntityTraits32x32>), sizeof(std::uint64_t));
+}
+
+TEST_F(EntityTest, ValueRoundTrips) {
+  Entity e{Entity::MAX_ID, Entity::MAX_VERSION};
+  EXPECT_EQ(Entity::FromValue(e.Value()), e);
+  EXPECT_EQ(Entity::FromValue(m_valid_entity.Value()), m_valid_entity);
+
+  using Wide = BasicEntity<EntityTraits32x32>;
+  Wide wide{0xFFFFFFFFu, 7};
+  EXPECT_EQ(Wide::FromValue(wide.Value()).id, 0xFFFFFFFFu);
+  EXPECT_EQ(Wide::FromValue(wide.Value()).ver, 7u);
+}
+
+TEST_F(EntityTest, FieldsAreMaskedToTheirBits) {
+  using Compact = BasicEntity<EntityTraits24x8>;
+  Compact e{0x1234567u, 0x1FFu};
+  EXPECT_EQ(e.id, 0x234567u);
+  EXPECT_EQ(e.ver, 0xFFu);
+}
+
+TEST_F(EntityTest, OrderingIsByIdThenVersion) {
+  EXPECT_TRUE((Entity{1, 9} < Entity{2, 1}));
+  EXPECT_TRUE((Entity{2, 1} < Entity{2, 2}));
+  EXPECT_TRUE((Entity{2, 2} > Entity{1, 9}));
+}
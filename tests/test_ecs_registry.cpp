@@ -1,3 +1,4 @@
+#include <algorithm>
 #include <stdexcept>
 #include <string>
 #include <unordered_set>
@@ -362,3 +363,677 @@ TEST_F(RegistryFixture, ViewSupportsMoveOnlyComponents) {
   }
   EXPECT_EQ(count, 1u);
 }
+
+
+TEST_F(RegistryFixture, RemoveKeepsOtherComponentsIntact) {
+  std::vector<SECSY::Entity> entities;
+  for (int i = 0; i < 8; ++i) {
+    auto e = reg.Create();
+    reg.Emplace<Position>(e, i, -i);
+    entities.push_back(e);
+  }
+
+  // swap-and-pop from the front, middle and back of the pool
+  reg.Remove<Position>(entities[0]);
+  reg.Remove<Position>(entities[4]);
+  reg.Remove<Position>(entities[7]);
+
+  for (int i = 0; i < 8; ++i) {
+    bool removed = (i == 0 || i == 4 || i == 7);
+    EXPECT_EQ(reg.Has<Position>(entities[i]), !removed);
+    if (!removed) {
+      EXPECT_EQ(reg.Get<Position>(entities[i]).x, i);
+      EXPECT_EQ(reg.Get<Position>(entities[i]).y, -i);
+    }
+  }
+}
+
+TEST_F(RegistryFixture, EmplaceOnSparseHighIds) {
+  std::vector<SECSY::Entity> entities;
+  for (int i = 0; i < 10000; ++i) {
+    entities.push_back(reg.Create());
+  }
+
+  // only touch ids from far apart sparse pages
+  reg.Emplace<Position>(entities[9999], 1, 1);
+  reg.Emplace<Position>(entities[10], 2, 2);
+
+  EXPECT_EQ(reg.Get<Position>(entities[9999]).x, 1);
+  EXPECT_EQ(reg.Get<Position>(entities[10]).x, 2);
+  EXPECT_FALSE(reg.Has<Position>(entities[5000]));
+}
+
+TEST_F(RegistryFixture, ViewDrivenBySmallestPool) {
+  std::vector<SECSY::Entity> entities;
+  for (int i = 0; i < 100; ++i) {
+    auto e = reg.Create();
+    reg.Emplace<Position>(e, i, i);
+    entities.push_back(e);
+  }
+  // only a handful carry the rarer component, listed second in the view
+  reg.Emplace<Velocity>(entities[3], 3.0f, 0.0f);
+  reg.Emplace<Velocity>(entities[42], 42.0f, 0.0f);
+  reg.Emplace<Velocity>(entities[99], 99.0f, 0.0f);
+
+  auto view = reg.View<Position, Velocity>();
+  EXPECT_EQ(view.SizeHint(), 3u);
+
+  size_t count = 0;
+  for (auto&& [entity, pos, vel] : view) {
+    EXPECT_EQ(static_cast<float>(pos.x), vel.dx);
+    EXPECT_EQ(&pos, &reg.Get<Position>(entity));
+    ++count;
+  }
+  EXPECT_EQ(count, 3u);
+}
+
+TEST_F(RegistryFixture, GroupPacksMatchingEntitiesInPrefix) {
+  std::vector<SECSY::Entity> entities;
+  for (int i = 0; i < 10; ++i) {
+    auto e = reg.Create();
+    reg.Emplace<Position>(e, i, i);
+    if (i % 2 == 0) {
+      reg.Emplace<Velocity>(e, static_cast<float>(i), 0.0f);
+    }
+    entities.push_back(e);
+  }
+
+  auto group = reg.Group<Position, Velocity>();
+  EXPECT_EQ(group.Size(), 5u);
+
+  // entities that join or leave later are tracked incrementally
+  reg.Emplace<Velocity>(entities[1], 1.0f, 0.0f);
+  reg.Remove<Position>(entities[4]);
+  reg.Destroy(entities[8]);
+  EXPECT_EQ(group.Size(), 4u);
+  EXPECT_TRUE(group.Contains(entities[1]));
+  EXPECT_FALSE(group.Contains(entities[4]));
+
+  std::unordered_set<SECSY::Entity> seen;
+  for (auto&& [entity, pos, vel] : group) {
+    EXPECT_EQ(static_cast<float>(pos.x), vel.dx);
+    EXPECT_EQ(&pos, &reg.Get<Position>(entity));
+    seen.insert(entity);
+  }
+  EXPECT_EQ(seen.size(), 4u);
+
+  group.Each([](SECSY::Entity, Position& pos, Velocity&) { pos.y = -1; });
+  EXPECT_EQ(reg.Get<Position>(entities[0]).y, -1);
+  EXPECT_EQ(reg.Get<Position>(entities[3]).y, 3);
+}
+
+TEST_F(RegistryFixture, GroupOwnershipIsExclusive) {
+  auto group = reg.Group<Position, Velocity>();
+  EXPECT_EQ((reg.Group<Position, Velocity>().Size()), group.Size());
+  EXPECT_THROW(reg.Group<Velocity>(), std::logic_error);
+  EXPECT_THROW((reg.Group<Tag, Position>()), std::logic_error);
+}
+
+TEST_F(RegistryFixture, TypeIDsAreDenseAndStable) {
+  auto id_pos = Internal::TypeID<Position>();
+  auto id_vel = Internal::TypeID<Velocity>();
+
+  // ids are assigned sequentially on first use and never change
+  EXPECT_LT(id_pos, static_cast<Internal::ComponentID>(SECSY_MAX_COMPONENTS));
+  EXPECT_LT(id_vel, static_cast<Internal::ComponentID>(SECSY_MAX_COMPONENTS));
+  EXPECT_EQ(Internal::TypeID<Position>(), id_pos);
+  EXPECT_EQ(Internal::TypeID<Velocity>(), id_vel);
+}
+
+TEST_F(RegistryFixture, VersionWrapsToOneAfterMax) {
+  // recycles one slot through every version, so only for narrow handles
+  if (SECSY::Entity::MAX_VERSION > (1u << 16)) {
+    GTEST_SKIP() << "version field too wide to wrap in a test";
+  }
+
+  auto e = reg.Create();
+  while (e.ver != SECSY::Entity::MAX_VERSION) {
+    reg.Destroy(e);
+    e = reg.Create();
+  }
+
+  reg.Destroy(e);
+  auto wrapped = reg.Create();
+  EXPECT_EQ(wrapped.id, e.id);
+  EXPECT_EQ(wrapped.ver, 1u);
+}
+
+TEST_F(RegistryFixture, StaleHandleIsNotAliveAfterRecycle) {
+  auto old_e = reg.Create();
+  reg.Destroy(old_e);
+  auto new_e = reg.Create();
+  ASSERT_EQ(new_e.id, old_e.id);
+
+  EXPECT_FALSE(reg.IsAlive(old_e));
+  EXPECT_TRUE(reg.IsAlive(new_e));
+  EXPECT_FALSE(reg.IsAlive(SECSY::Entity::Null));
+
+  // destroying through the stale handle must not touch the new entity
+  reg.Emplace<Position>(new_e, 1, 2);
+  reg.Destroy(old_e);
+  EXPECT_TRUE(reg.IsAlive(new_e));
+  EXPECT_TRUE(reg.Has<Position>(new_e));
+
+  // and must not push the id onto the free list a second time
+  auto a = reg.Create();
+  auto b = reg.Create();
+  EXPECT_NE(a.id, b.id);
+  EXPECT_NE(a.id, new_e.id);
+}
+
+TEST_F(RegistryFixture, FreeListRecyclesEveryDestroyedId) {
+  std::vector<SECSY::Entity> entities;
+  for (int i = 0; i < 16; ++i) {
+    entities.push_back(reg.Create());
+  }
+  for (auto e : entities) {
+    reg.Destroy(e);
+  }
+
+  std::unordered_set<SECSY::Entity::id_type> ids;
+  for (int i = 0; i < 16; ++i) {
+    auto e = reg.Create();
+    EXPECT_EQ(e.ver, 2u);
+    ids.insert(e.id);
+  }
+  EXPECT_EQ(ids.size(), 16u);
+
+  // free list exhausted, fresh ids continue after the old range
+  EXPECT_EQ(reg.Create().id, 17u);
+}
+
+TEST_F(RegistryFixture, CreateRangeRecyclesThenAppends) {
+  auto a = reg.Create();
+  auto b = reg.Create();
+  reg.Destroy(a);
+
+  std::vector<SECSY::Entity> entities(4);
+  reg.Create(entities.begin(), entities.end());
+
+  EXPECT_EQ(entities[0].id, a.id);  // recycled id comes first
+  EXPECT_EQ(entities[0].ver, 2u);
+  std::unordered_set<SECSY::Entity::id_type> ids;
+  for (auto e : entities) {
+    EXPECT_TRUE(reg.IsAlive(e));
+    EXPECT_NE(e.id, b.id);
+    ids.insert(e.id);
+  }
+  EXPECT_EQ(ids.size(), 4u);
+  EXPECT_EQ(reg.Create().id, 6u);
+}
+
+TEST_F(RegistryFixture, InsertFromValueAndRange) {
+  std::vector<SECSY::Entity> entities(5);
+  reg.Create(entities.begin(), entities.end());
+  reg.Emplace<Position>(entities[2], 9, 9);  // overwritten below
+
+  reg.Insert(entities.begin(), entities.end(), Position{1, 2});
+  for (auto e : entities) {
+    EXPECT_TRUE(reg.Has<Position>(e));
+    EXPECT_EQ(reg.Get<Position>(e).x, 1);
+    EXPECT_EQ(reg.Get<Position>(e).y, 2);
+  }
+
+  std::vector<Velocity> velocities{{0, 0}, {1, 0}, {2, 0}};
+  reg.Insert<Velocity>(
+      entities.begin() + 1, entities.begin() + 4, velocities.begin());
+  EXPECT_FALSE(reg.Has<Velocity>(entities[0]));
+  EXPECT_FLOAT_EQ(reg.Get<Velocity>(entities[1]).dx, 0.0f);
+  EXPECT_FLOAT_EQ(reg.Get<Velocity>(entities[3]).dx, 2.0f);
+  EXPECT_FALSE(reg.Has<Velocity>(entities[4]));
+
+  size_t count = 0;
+  for (auto&& [entity, pos, vel] : reg.View<Position, Velocity>()) {
+    (void)entity;
+    EXPECT_EQ(pos.x, 1);
+    ++count;
+  }
+  EXPECT_EQ(count, 3u);
+}
+
+TEST_F(RegistryFixture, InsertCopiesFromTheSamePool) {
+  auto source = reg.Create();
+  reg.Emplace<Tag>(source, std::string(64, 'x'));  // past any short buffer
+
+  // growing the pool moves the source value; the copy must be taken first
+  std::vector<SECSY::Entity> entities(100);
+  reg.Create(entities.begin(), entities.end());
+  entities.push_back(source);  // and overwriting it with itself is fine
+  reg.Insert<Tag>(entities.begin(), entities.end(), reg.Get<Tag>(source));
+  for (auto e : entities) {
+    EXPECT_EQ(reg.Get<Tag>(e).name, std::string(64, 'x'));
+  }
+}
+
+TEST_F(RegistryFixture, InsertOnDeadEntityChangesNothing) {
+  std::vector<SECSY::Entity> entities(3);
+  reg.Create(entities.begin(), entities.end());
+  reg.Destroy(entities[1]);
+
+  EXPECT_THROW(reg.Insert(entities.begin(), entities.end(), Position{1, 1}),
+               std::out_of_range);
+  EXPECT_FALSE(reg.Has<Position>(entities[0]));
+  EXPECT_FALSE(reg.Has<Position>(entities[2]));
+}
+
+TEST_F(RegistryFixture, ParallelEachMatchesSerialEach) {
+  std::vector<SECSY::Entity> entities(10'000);
+  reg.Create(entities.begin(), entities.end());
+  for (size_t i = 0; i < entities.size(); ++i) {
+    reg.Emplace<Position>(entities[i], static_cast<int>(i), 0);
+    if (i % 3 == 0) {
+      reg.Emplace<Velocity>(entities[i], 1.0f, 2.0f);
+    }
+  }
+
+  SECSY::JobSystem jobs(4);
+  reg.View<Position, Velocity>().ParallelEach(
+      jobs,
+      [](SECSY::Entity, Position& pos, Velocity& vel) {
+        pos.y = pos.x + static_cast<int>(vel.dy);
+      },
+      128);
+
+  size_t count = 0;
+  reg.View<Position>().Each([&](SECSY::Entity e, Position& pos) {
+    EXPECT_EQ(pos.y, reg.Has<Velocity>(e) ? pos.x + 2 : 0);
+    ++count;
+  });
+  EXPECT_EQ(count, entities.size());
+}
+
+TEST_F(RegistryFixture, ChangedViewOnlyYieldsTouchedEntities) {
+  std::vector<SECSY::Entity> entities(100);
+  reg.Create(entities.begin(), entities.end());
+  reg.Insert(entities.begin(), entities.end(), Position{0, 0});
+  reg.Insert(entities.begin(), entities.end(), Velocity{0, 0});
+
+  // a consumer that has never run sees everything
+  SECSY::Tick since = 0;
+  size_t count      = 0;
+  reg.View<const Position>(SECSY::Changed<Position>{since})
+      .Each([&](SECSY::Entity, const Position&) { ++count; });
+  EXPECT_EQ(count, 100u);
+  since = reg.AdvanceTick();
+
+  reg.Get<Position>(entities[3]).x = 1;
+  reg.Emplace<Position>(entities[50], 2, 2);
+  std::as_const(reg).Get<Position>(entities[60]);  // reads do not count
+
+  std::unordered_set<SECSY::Entity> seen;
+  for (auto&& [entity, pos, vel] :
+       reg.View<Position, const Velocity>(SECSY::Changed<Position>{since})) {
+    (void)pos;
+    (void)vel;
+    seen.insert(entity);
+  }
+  EXPECT_EQ(seen.size(), 2u);
+  EXPECT_TRUE(seen.count(entities[3]));
+  EXPECT_TRUE(seen.count(entities[50]));
+
+  // the view above only read Velocity, so nothing shows up as changed
+  count = 0;
+  reg.View<const Velocity>(SECSY::Changed<Velocity>{since})
+      .Each([&](SECSY::Entity, const Velocity&) { ++count; });
+  EXPECT_EQ(count, 0u);
+}
+
+TEST_F(RegistryFixture, FilteredViewsVisitOnlyWhatChanged) {
+  std::vector<SECSY::Entity> entities(1000);
+  reg.Create(entities.begin(), entities.end());
+  reg.Insert(entities.begin(), entities.end(), Position{0, 0});
+  for (size_t i = 0; i < 10; ++i) {
+    reg.Emplace<Velocity>(entities[i * 100], 1.0f, 1.0f);
+  }
+  SECSY::Tick since = reg.AdvanceTick();
+  reg.Get<Position>(entities[0]).x   = 1;  // has a Velocity
+  reg.Get<Position>(entities[1]).x   = 1;  // does not
+  reg.Get<Position>(entities[300]).x = 1;  // has a Velocity
+  reg.Get<Position>(entities[300]).y = 1;  // listed once per tick
+  reg.Emplace<Position>(entities[1000 - 1], 2, 2);  // replaced, also listed
+
+  // the slots stamped this tick drive, not the 1000 Positions or the ten
+  // Velocities; rejected entities are not stamped changed
+  auto view =
+      reg.View<Position, const Velocity>(SECSY::Changed<Position>{since});
+  EXPECT_EQ(view.SizeHint(), 4u);
+  std::vector<SECSY::Entity> seen;
+  view.Each([&](SECSY::Entity e, Position&, const Velocity&) {
+    seen.push_back(e);
+  });
+  std::sort(seen.begin(), seen.end());
+  EXPECT_EQ(seen, (std::vector<SECSY::Entity>{entities[0], entities[300]}));
+
+  auto count = [&](SECSY::Tick from) {
+    size_t n = 0;
+    reg.View<const Position>(SECSY::Changed<Position>{from})
+        .Each([&](SECSY::Entity, const Position&) { ++n; });
+    return n;
+  };
+  EXPECT_EQ(count(since), 4u);
+
+  // removed entities leave the list; older ticks test the whole pool
+  reg.Destroy(entities[1]);
+  EXPECT_EQ(reg.View<const Position>(SECSY::Changed<Position>{since})
+                .SizeHint(),
+            3u);
+  EXPECT_EQ(count(since - 1), 999u);
+
+  // the next tick starts an empty list
+  since = reg.AdvanceTick();
+  EXPECT_EQ(count(since), 0u);
+  reg.Get<Position>(entities[2]).x = 3;
+  EXPECT_EQ(count(since), 1u);
+}
+
+TEST_F(RegistryFixture, AddedViewTracksNewComponents) {
+  std::vector<SECSY::Entity> entities(10);
+  reg.Create(entities.begin(), entities.end());
+  reg.Insert(entities.begin(), entities.end(), Position{0, 0});
+  SECSY::Tick since = reg.AdvanceTick();
+
+  reg.Emplace<Position>(entities[0], 5, 5);  // replaced, not added
+  reg.Remove<Position>(entities[1]);
+  reg.Emplace<Position>(entities[1], 7, 7);  // added again
+
+  size_t count = 0;
+  for (auto&& [entity, pos] :
+       reg.View<const Position>(SECSY::Added<Position>{since})) {
+    EXPECT_EQ(entity, entities[1]);
+    EXPECT_EQ(pos.x, 7);
+    ++count;
+  }
+  EXPECT_EQ(count, 1u);
+
+  // mutable iteration stamps every visited component
+  since = reg.AdvanceTick();
+  reg.View<Position>().Each([](SECSY::Entity, Position&) {});
+  count = 0;
+  reg.View<const Position>(SECSY::Changed<Position>{since})
+      .Each([&](SECSY::Entity, const Position&) { ++count; });
+  EXPECT_EQ(count, 10u);
+}
+
+TEST_F(RegistryFixture, LifecycleSignalsFireOnStructuralChanges) {
+  std::vector<std::string> log;
+  auto record = [&](const char* what) {
+    return [&log, what](SECSY::Registry&, SECSY::Entity) {
+      log.emplace_back(what);
+    };
+  };
+  reg.OnConstruct<Position>().Connect(record("construct"));
+  reg.OnUpdate<Position>().Connect(record("update"));
+  reg.OnDestroy<Position>().Connect(
+      [&](SECSY::Registry& r, SECSY::Entity e) {
+        // the component is still readable while it is being destroyed
+        log.push_back("destroy " + std::to_string(r.Get<Position>(e).x));
+      });
+
+  auto e = reg.Create();
+  reg.Emplace<Position>(e, 1, 0);
+  reg.Emplace<Position>(e, 2, 0);
+  reg.Replace<Position>(e, 3, 0);
+  reg.Patch<Position>(e, [](Position& pos) { ++pos.x; });
+  reg.Remove<Position>(e);
+  reg.Remove<Position>(e);  // nothing left to remove, no signal
+  reg.Emplace<Position>(e, 9, 0);
+  reg.Emplace<Velocity>(e, 0.0f, 0.0f);  // other types stay silent
+  reg.Destroy(e);
+
+  const std::vector<std::string> expected = {"construct",
+                                             "update",
+                                             "update",
+                                             "update",
+                                             "destroy 4",
+                                             "construct",
+                                             "destroy 9"};
+  EXPECT_EQ(log, expected);
+}
+
+TEST_F(RegistryFixture, DestroyListenersMayChangeTheDyingEntity) {
+  // a Position listener takes the Velocity with it, creating entities (and
+  // growing the slot table) on the way: Velocity is destroyed once either way
+  int positions = 0, velocities = 0;
+  reg.OnDestroy<Position>().Connect([&](SECSY::Registry& r, SECSY::Entity e) {
+    ++positions;
+    r.Remove<Velocity>(e);
+    std::vector<SECSY::Entity> more(256);
+    r.Create(more.begin(), more.end());
+  });
+  reg.OnDestroy<Velocity>().Connect(
+      [&](SECSY::Registry&, SECSY::Entity) { ++velocities; });
+
+  auto e = reg.Create();
+  reg.Emplace<Position>(e, 1, 0);
+  reg.Emplace<Velocity>(e, 0.0f, 0.0f);
+  reg.Destroy(e);
+  EXPECT_EQ(positions, 1);
+  EXPECT_EQ(velocities, 1);
+  EXPECT_FALSE(reg.IsAlive(e));
+  EXPECT_EQ(reg.View<const Position>().SizeHint(), 0u);
+  EXPECT_EQ(reg.View<const Velocity>().SizeHint(), 0u);
+}
+
+TEST_F(RegistryFixture, ThrowingDestroyListenerLeavesTheComponent) {
+  auto e = reg.Create();
+  reg.Emplace<Position>(e, 1, 0);
+  reg.OnDestroy<Position>().Connect([](SECSY::Registry&, SECSY::Entity) {
+    throw std::runtime_error("veto");
+  });
+
+  EXPECT_THROW(reg.Remove<Position>(e), std::runtime_error);
+  ASSERT_TRUE(reg.Has<Position>(e));
+  EXPECT_EQ(reg.Get<Position>(e).x, 1);
+}
+
+TEST_F(RegistryFixture, SignalsMaintainDerivedIndex) {
+  // an index of entities by x, kept in sync without rescanning the pool
+  std::unordered_set<int> xs;
+  reg.OnConstruct<Position>().Connect(
+      [&](SECSY::Registry& r, SECSY::Entity e) {
+        xs.insert(r.Get<Position>(e).x);
+      });
+  auto on_destroy = reg.OnDestroy<Position>().Connect(
+      [&](SECSY::Registry& r, SECSY::Entity e) {
+        xs.erase(r.Get<Position>(e).x);
+      });
+
+  std::vector<SECSY::Entity> entities(4);
+  reg.Create(entities.begin(), entities.end());
+  std::vector<Position> values = {{0, 0}, {1, 0}, {2, 0}, {3, 0}};
+  reg.Insert<Position>(entities.begin(), entities.end(), values.begin());
+  EXPECT_EQ(xs.size(), 4u);
+
+  reg.Destroy(entities[1]);
+  reg.Remove<Position>(entities[2]);
+  EXPECT_EQ(xs, (std::unordered_set<int>{0, 3}));
+
+  reg.OnDestroy<Position>().Disconnect(on_destroy);
+  reg.Remove<Position>(entities[3]);
+  EXPECT_EQ(xs, (std::unordered_set<int>{0, 3}));
+}
+
+struct Enemy {};
+struct Selected {};
+
+TEST_F(RegistryFixture, TagComponentsShareOneInstance) {
+  static_assert(Internal::ComponentStorage<Enemy>::IS_TAG);
+  static_assert(!Internal::ComponentStorage<Position>::IS_TAG);
+
+  auto a = reg.Create();
+  auto b = reg.Create();
+  reg.Emplace<Enemy>(a);
+  reg.Emplace<Enemy>(b);
+  reg.Emplace<Enemy>(b);  // re-tagging is harmless
+
+  EXPECT_TRUE(reg.Has<Enemy>(a));
+  EXPECT_EQ(&reg.Get<Enemy>(a), &reg.Get<Enemy>(b));
+
+  reg.Remove<Enemy>(a);
+  EXPECT_FALSE(reg.Has<Enemy>(a));
+  EXPECT_TRUE(reg.Has<Enemy>(b));
+  EXPECT_THROW(reg.Get<Enemy>(a), std::out_of_range);
+}
+
+TEST_F(RegistryFixture, ViewsMixTagsAndData) {
+  std::vector<SECSY::Entity> entities(100);
+  reg.Create(entities.begin(), entities.end());
+  reg.Insert(entities.begin(), entities.end(), Position{1, 0});
+  for (size_t i = 0; i < entities.size(); i += 4) {
+    reg.Emplace<Enemy>(entities[i]);
+  }
+  for (size_t i = 0; i < entities.size(); i += 8) {
+    reg.Emplace<Selected>(entities[i]);
+  }
+  reg.Remove<Enemy>(entities[8]);
+
+  size_t count = 0;
+  reg.View<Position, Enemy, const Selected>().Each(
+      [&](SECSY::Entity e, Position& pos, Enemy&, const Selected&) {
+        EXPECT_TRUE(reg.Has<Enemy>(e));
+        EXPECT_TRUE(reg.Has<Selected>(e));
+        pos.y = 1;
+        ++count;
+      });
+  EXPECT_EQ(count, 12u);
+
+  count = 0;
+  for (auto&& [entity, enemy] : reg.View<Enemy>()) {
+    (void)enemy;
+    EXPECT_EQ(reg.Get<Position>(entity).x, 1);
+    ++count;
+  }
+  EXPECT_EQ(count, 24u);
+}
+
+TEST_F(RegistryFixture, SortOrdersPoolAndKeepsLookups) {
+  std::vector<SECSY::Entity> entities(200);
+  reg.Create(entities.begin(), entities.end());
+  for (size_t i = 0; i < entities.size(); ++i) {
+    reg.Emplace<Position>(entities[i], static_cast<int>((i * 37) % 101), 0);
+  }
+  reg.Remove<Position>(entities[5]);  // a hole from churn
+
+  reg.Sort<Position>(
+      [](const Position& a, const Position& b) { return a.x < b.x; });
+
+  int last = -1;
+  size_t count = 0;
+  reg.View<const Position>().Each([&](SECSY::Entity e, const Position& pos) {
+    EXPECT_LE(last, pos.x);
+    EXPECT_EQ(reg.Get<Position>(e).x, pos.x);
+    last = pos.x;
+    ++count;
+  });
+  EXPECT_EQ(count, entities.size() - 1);
+
+  // by a compile-time key, then by entity handle
+  reg.Sort<Position, &Position::x>();
+  reg.Sort<Position>([](SECSY::Entity a, SECSY::Entity b) { return b < a; });
+  SECSY::Entity previous = SECSY::Entity::Null;
+  for (auto&& [entity, pos] : reg.View<const Position>()) {
+    if (previous != SECSY::Entity::Null) {
+      EXPECT_LT(entity, previous);
+    }
+    auto i = static_cast<size_t>(entity.id - entities[0].id);
+    EXPECT_EQ(pos.x, static_cast<int>((i * 37) % 101));
+    previous = entity;
+  }
+}
+
+namespace {
+
+struct Counted {
+  static inline int moves = 0;
+
+  int v;
+  explicit Counted(int v) : v(v) {}
+  Counted(Counted &&o) noexcept : v(o.v) {
+    ++moves;
+  }
+  Counted &operator=(Counted &&o) noexcept {
+    v = o.v;
+    ++moves;
+    return *this;
+  }
+};
+
+}  // namespace
+
+TEST_F(RegistryFixture, SortMovesEachComponentOnce) {
+  constexpr int N = 64;
+  std::vector<SECSY::Entity> entities(N);
+  reg.Create(entities.begin(), entities.end());
+  for (int i = 0; i < N; ++i) {
+    reg.Emplace<Counted>(entities[i], (i + 1) % N);  // one cycle of length N
+  }
+
+  Counted::moves = 0;
+  reg.Sort<Counted>([](const Counted &a, const Counted &b) {
+    return a.v < b.v;
+  });
+  EXPECT_EQ(Counted::moves, N + 1);  // once each, plus out of the temporary
+
+  int expected = 0;
+  for (auto &&[entity, c] : reg.View<const Counted>()) {
+    EXPECT_EQ(c.v, expected++);
+    EXPECT_EQ(reg.Get<Counted>(entity).v, c.v);
+  }
+}
+
+TEST_F(RegistryFixture, SortAsMatchesAnotherPool) {
+  std::vector<SECSY::Entity> entities(50);
+  reg.Create(entities.begin(), entities.end());
+  for (size_t i = 0; i < entities.size(); ++i) {
+    reg.Emplace<Position>(entities[i], static_cast<int>(i), 0);
+    if (i % 3 != 0) {
+      reg.Emplace<Velocity>(entities[entities.size() - 1 - i], 1.0f, 0.0f);
+    }
+  }
+  reg.Emplace<Enemy>(entities[10]);
+  reg.Emplace<Enemy>(entities[2]);
+
+  reg.Sort<Position>(
+      [](const Position& a, const Position& b) { return a.x > b.x; });
+  reg.SortAs<Velocity, Position>();
+  reg.SortAs<Enemy, Position>();
+
+  std::vector<SECSY::Entity> position_order;
+  for (auto&& [entity, pos] : reg.View<const Position>()) {
+    (void)pos;
+    if (reg.Has<Velocity>(entity)) {
+      position_order.push_back(entity);
+    }
+  }
+  std::vector<SECSY::Entity> velocity_order;
+  for (auto&& [entity, vel] : reg.View<const Velocity>()) {
+    (void)vel;
+    velocity_order.push_back(entity);
+  }
+  EXPECT_EQ(velocity_order, position_order);
+
+  std::vector<SECSY::Entity> enemies;
+  for (auto&& [entity, enemy] : reg.View<Enemy>()) {
+    (void)enemy;
+    enemies.push_back(entity);
+  }
+  EXPECT_EQ(enemies, (std::vector<SECSY::Entity>{entities[10], entities[2]}));
+}
+
+TEST_F(RegistryFixture, SortRefusesGroupsAndRecordings) {
+  auto e = reg.Create();
+  reg.Emplace<Position>(e, 1, 1);
+  reg.Emplace<Velocity>(e, 1.0f, 1.0f);
+  reg.Group<Position>();
+
+  auto by_x = [](const Position& a, const Position& b) { return a.x < b.x; };
+  EXPECT_THROW(reg.Sort<Position>(by_x), std::logic_error);
+  EXPECT_THROW((reg.SortAs<Position, Velocity>()), std::logic_error);
+  reg.Sort<Velocity, &Velocity::dx>();  // not owned, still sortable
+
+  SECSY::Registry recorded;
+  recorded.Emplace<Position>(recorded.Create(), 1, 1);
+  SECSY::Delta delta;
+  recorded.Record(delta);
+  EXPECT_THROW(recorded.Sort<Position>(by_x), std::logic_error);
+}
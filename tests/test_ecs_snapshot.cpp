@@ -0,0 +1,186 @@
+#include <cstddef>
+#include <cstring>
+#include <filesystem>
+#include <span>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <SECSY/ECS/Registry.hpp>
+#include <SECSY/ECS/Snapshot.hpp>
+
+namespace {
+
+struct Position {
+  int x, y;
+};
+
+struct Frozen {};
+
+// not trivially copyable, saved through SnapshotTraits
+struct Name {
+  std::string value;
+};
+
+}  // namespace
+
+template <>
+struct SECSY::SnapshotTraits<Name> {
+  static void Save(SnapshotWriter& out_, const Name& name_) {
+    out_.WriteString(name_.value);
+  }
+
+  static Name Load(SnapshotReader& in_) {
+    return Name{in_.ReadString()};
+  }
+};
+
+using WorldSnapshot = SECSY::Snapshot<Position, Frozen, Name>;
+
+namespace {
+
+std::string Save(const SECSY::Registry& registry_) {
+  std::ostringstream out(std::ios::binary);
+  WorldSnapshot::Save(registry_, out);
+  return std::move(out).str();
+}
+
+std::span<const std::byte> Bytes(const std::string& data_) {
+  return std::as_bytes(std::span(data_.data(), data_.size()));
+}
+
+}  // namespace
+
+TEST(Snapshot_Registry, RoundTripKeepsEntitiesAndComponents) {
+  SECSY::Registry source;
+  std::vector<SECSY::Entity> entities(1000);
+  source.Create(entities.begin(), entities.end());
+  for (std::size_t i = 0; i < entities.size(); ++i) {
+    source.Emplace<Position>(entities[i], static_cast<int>(i), -1);
+    if (i % 10 == 0) {
+      source.Emplace<Frozen>(entities[i]);
+      source.Emplace<Name>(entities[i], "e" + std::to_string(i));
+    }
+  }
+  source.Destroy(entities[3]);
+  source.Destroy(entities[500]);
+
+  std::string data = Save(source);
+
+  SECSY::Registry loaded;
+  loaded.Emplace<Position>(loaded.Create(), 7, 7);  // replaced by the load
+  WorldSnapshot::Load(loaded, Bytes(data));
+
+  for (std::size_t i = 0; i < entities.size(); ++i) {
+    SECSY::Entity e = entities[i];
+    ASSERT_EQ(loaded.IsAlive(e), source.IsAlive(e));
+    if (!source.IsAlive(e)) {
+      continue;
+    }
+    EXPECT_EQ(loaded.Get<Position>(e).x, static_cast<int>(i));
+    EXPECT_EQ(loaded.Has<Frozen>(e), i % 10 == 0);
+    if (i % 10 == 0) {
+      EXPECT_EQ(loaded.Get<Name>(e).value, "e" + std::to_string(i));
+    }
+  }
+
+  // the free list survives: both registries recycle the same slots
+  EXPECT_EQ(loaded.Create(), source.Create());
+  EXPECT_EQ(loaded.Create(), source.Create());
+}
+
+TEST(Snapshot_Registry, LoadedPoolsWorkInViews) {
+  SECSY::Registry source;
+  for (int i = 0; i < 100; ++i) {
+    auto e = source.Create();
+    source.Emplace<Position>(e, i, 0);
+    if (i % 2 == 0) {
+      source.Emplace<Frozen>(e);
+    }
+  }
+
+  SECSY::Registry loaded;
+  WorldSnapshot::Load(loaded, Bytes(Save(source)));
+
+  int sum = 0;
+  loaded.View<const Position, const Frozen>().Each(
+      [&](SECSY::Entity, const Position& pos, const Frozen&) {
+        sum += pos.x;
+      });
+  EXPECT_EQ(sum, 2450);
+}
+
+TEST(Snapshot_Registry, MalformedInputThrowsAndLeavesRegistryEmpty) {
+  SECSY::Registry source;
+  auto e = source.Create();
+  source.Emplace<Position>(e, 1, 2);
+  std::string data = Save(source);
+
+  SECSY::Registry loaded;
+  std::string truncated = data.substr(0, data.size() - 4);
+  EXPECT_THROW(WorldSnapshot::Load(loaded, Bytes(truncated)),
+               std::runtime_error);
+  EXPECT_FALSE(loaded.IsAlive(e));
+
+  std::string garbage = data;
+  garbage[0]          = 'X';
+  EXPECT_THROW(WorldSnapshot::Load(loaded, Bytes(garbage)),
+               std::runtime_error);
+
+  // a different schema is rejected too
+  EXPECT_THROW(SECSY::Snapshot<Name>::Load(loaded, Bytes(data)),
+               std::runtime_error);
+}
+
+TEST(Snapshot_Registry, CorruptSlotTablesAreRejected) {
+  SECSY::Registry source;
+  std::vector<SECSY::Entity> entities(4);  // ids 1 to 4
+  source.Create(entities.begin(), entities.end());
+  source.Destroy(entities[1]);
+  source.Destroy(entities[3]);  // free list: 4 -> 2 -> end
+  const std::string data = Save(source);
+
+  // the slot table follows the 44 byte header
+  auto with_slot = [&](std::size_t id_, SECSY::Entity slot_) {
+    std::string bytes = data;
+    std::memcpy(bytes.data() + 44 + id_ * sizeof(slot_), &slot_, sizeof(slot_));
+    return bytes;
+  };
+
+  SECSY::Registry loaded;
+  WorldSnapshot::Load(loaded, Bytes(data));
+  EXPECT_TRUE(loaded.IsAlive(entities[2]));
+
+  const std::string corrupt[] = {
+      with_slot(0, SECSY::Entity{0, 1}),   // null slot made live
+      with_slot(1, SECSY::Entity{3, 1}),   // live slot naming another id
+      with_slot(3, SECSY::Entity{3, 0}),   // live slot with version 0
+      with_slot(4, SECSY::Entity{9, 2}),   // free link past the table
+      with_slot(2, SECSY::Entity{4, 2}),   // free list loops 4 -> 2 -> 4
+      with_slot(4, SECSY::Entity{4, 2}),   // free slot links to itself
+  };
+  for (const auto& bytes : corrupt) {
+    EXPECT_THROW(WorldSnapshot::Load(loaded, Bytes(bytes)),
+                 std::runtime_error);
+    EXPECT_FALSE(loaded.IsAlive(entities[0]));
+  }
+}
+
+TEST(Snapshot_Registry, FileRoundTripThroughMapping) {
+  SECSY::Registry source;
+  std::vector<SECSY::Entity> entities(256);
+  source.Create(entities.begin(), entities.end());
+  source.Insert(entities.begin(), entities.end(), Position{4, 2});
+
+  auto path = std::filesystem::temp_directory_path() / "secsy_snapshot.bin";
+  WorldSnapshot::SaveFile(source, path);
+
+  SECSY::Registry loaded;
+  WorldSnapshot::LoadFile(loaded, path);
+  std::filesystem::remove(path);
+
+  EXPECT_EQ(loaded.Get<Position>(entities.back()).y, 2);
+}
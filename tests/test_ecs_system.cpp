@@ -0,0 +1,113 @@
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <SECSY/ECS/System.hpp>
+
+namespace {
+
+struct Position {
+  float x, y;
+};
+
+struct Velocity {
+  float dx, dy;
+};
+
+struct Health {
+  int hp;
+};
+
+}  // namespace
+
+using SECSY::Read;
+using SECSY::Write;
+
+class SchedulerFixture : public ::testing::Test {
+ protected:
+  SECSY::Registry reg;
+  SECSY::JobSystem jobs{3};
+  SECSY::Scheduler scheduler{jobs};
+};
+
+TEST_F(SchedulerFixture, ConflictingSystemsAreStagedInOrder) {
+  scheduler.Add<Read<Velocity>, Write<Position>>("move", [](auto&) {})
+      .Add<Read<>, Write<Health>>("regen", [](auto&) {})
+      .Add<Read<Position>>("draw", [](auto&) {})
+      .Add<Read<Position>>("audio", [](auto&) {})
+      .Add<Read<>, Write<Velocity>>("steer", [](auto&) {});
+
+  EXPECT_EQ(scheduler.StageOf("move"), 0u);
+  EXPECT_EQ(scheduler.StageOf("regen"), 0u);   // disjoint from move
+  EXPECT_EQ(scheduler.StageOf("draw"), 1u);    // reads what move writes
+  EXPECT_EQ(scheduler.StageOf("audio"), 1u);   // readers share a stage
+  EXPECT_EQ(scheduler.StageOf("steer"), 1u);   // writes what move reads
+  EXPECT_EQ(scheduler.StageOf("missing"), SECSY::Scheduler::npos);
+  EXPECT_EQ(scheduler.StageCount(), 2u);
+}
+
+TEST_F(SchedulerFixture, RunAppliesSystemsInDependencyOrder) {
+  auto e = reg.Create();
+  reg.Emplace<Position>(e, 0.0f, 0.0f);
+  reg.Emplace<Velocity>(e, 1.0f, 2.0f);
+
+  std::mutex mutex;
+  std::vector<std::string> order;
+  auto log = [&](const char* name) {
+    std::lock_guard lock(mutex);
+    order.push_back(name);
+  };
+
+  scheduler
+      .Add<Read<Velocity>, Write<Position>>(
+          "move",
+          [&](SECSY::Registry& r) {
+            log("move");
+            r.View<Position, const Velocity>().Each(
+                [](SECSY::Entity, Position& pos, const Velocity& vel) {
+                  pos.x += vel.dx;
+                  pos.y += vel.dy;
+                });
+          })
+      .Add<Read<Position>>("check", [&](const SECSY::Registry& r) {
+        log("check");
+        EXPECT_FLOAT_EQ(r.Get<Position>(e).x, 1.0f);
+      });
+
+  auto since = reg.AdvanceTick();
+  scheduler.Run(reg);
+  ASSERT_EQ(order.size(), 2u);
+  EXPECT_EQ(order[0], "move");
+  EXPECT_EQ(order[1], "check");
+
+  // only what move declared as written was stamped changed
+  auto changed = [&]<typename T>(SECSY::Changed<T> filter) {
+    std::size_t count = 0;
+    reg.View<const T>(filter).Each([&](SECSY::Entity, const T&) { ++count; });
+    return count != 0;
+  };
+  EXPECT_TRUE(changed(SECSY::Changed<Position>{since}));
+  EXPECT_FALSE(changed(SECSY::Changed<Velocity>{since}));
+}
+
+TEST_F(SchedulerFixture, CommandBuffersFlushAfterTheirStage) {
+  std::atomic<int> seen{-1};
+  scheduler
+      .Add<Read<>, Write<Health>>(
+          "spawn",
+          [](SECSY::Registry&, SECSY::CommandBuffer& cmd) {
+            cmd.Emplace<Health>(cmd.Create(), 5);
+          })
+      .Add<Read<Health>>("count", [&](const SECSY::Registry& r) {
+        seen = static_cast<int>(r.View<const Health>().SizeHint());
+      });
+
+  scheduler.Run(reg);
+  EXPECT_EQ(seen.load(), 1);
+  scheduler.Run(reg);
+  EXPECT_EQ(seen.load(), 2);
+}
@@ -0,0 +1,200 @@
+#include <algorithm>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <SECSY/ECS/Registry.hpp>
+#include <SECSY/Render/HeadlessBackend.hpp>
+#include <SECSY/Render/Renderer.hpp>
+#include <SECSY/Render/SpatialGrid.hpp>
+#include <SECSY/Render/System.hpp>
+#include <SECSY/Render/TextureCache.hpp>
+
+using HeadlessRenderer = SECSY::BasicRenderer<SECSY::HeadlessBackend>;
+
+namespace {
+
+// every path is a 16x16 texture, no GPU involved
+struct FakeLoader {
+  unsigned int next{1};
+
+  Texture2D Load(const char*) {
+    return Texture2D{next++, 16, 16, 1, 0};
+  }
+
+  void Unload(Texture2D) {}
+};
+
+using FakeCache = SECSY::BasicTextureCache<FakeLoader>;
+
+std::vector<SECSY::Entity> Query(const SECSY::SpatialGrid& grid_,
+                                 Rectangle area_) {
+  std::vector<SECSY::Entity> found;
+  grid_.Query(area_, found);
+  std::sort(found.begin(), found.end());
+  return found;
+}
+
+// a 16x16 sprite with its top-left corner at x_, y_
+SECSY::Entity Spawn(SECSY::Registry& reg_,
+                    FakeCache& textures_,
+                    float x_,
+                    float y_) {
+  auto e = reg_.Create();
+  reg_.Emplace<SECSY::Transform>(e, Vector2{x_, y_}, 0.0f, Vector2{1, 1});
+  reg_.Emplace<SECSY::Sprite>(e,
+                              textures_.Load("sprite.png"),
+                              Rectangle{0, 0, 16, 16},
+                              Color{255, 255, 255, 255},
+                              0);
+  return e;
+}
+
+std::vector<SECSY::Entity> Drawn(const SECSY::RenderSystem& system_) {
+  auto drawn = system_.Visible();
+  std::sort(drawn.begin(), drawn.end());
+  return drawn;
+}
+
+}  // namespace
+
+TEST(Render_SpatialGrid, QueryReportsEachOverlapOnce) {
+  SECSY::SpatialGrid grid(32);
+  SECSY::Entity small{1, 0};
+  SECSY::Entity large{2, 0};
+  SECSY::Entity negative{3, 0};
+
+  grid.Update(small, Rectangle{10, 10, 4, 4});
+  grid.Update(large, Rectangle{0, 0, 100, 100});  // spans 4x4 cells
+  grid.Update(negative, Rectangle{-50, -50, 10, 10});
+  EXPECT_EQ(grid.Size(), 3u);
+
+  EXPECT_EQ(Query(grid, Rectangle{-64, -64, 256, 256}),
+            (std::vector<SECSY::Entity>{small, large, negative}));
+  EXPECT_EQ(Query(grid, Rectangle{40, 40, 40, 40}),
+            (std::vector<SECSY::Entity>{large}));
+  // same cells as small, but not touching it
+  EXPECT_EQ(Query(grid, Rectangle{20, 20, 4, 4}),
+            (std::vector<SECSY::Entity>{large}));
+  EXPECT_TRUE(Query(grid, Rectangle{200, 200, 10, 10}).empty());
+
+  grid.Update(large, Rectangle{300, 300, 10, 10});
+  EXPECT_EQ(Query(grid, Rectangle{0, 0, 64, 64}),
+            (std::vector<SECSY::Entity>{small}));
+  EXPECT_EQ(Query(grid, Rectangle{290, 290, 64, 64}),
+            (std::vector<SECSY::Entity>{large}));
+
+  grid.Remove(small);
+  grid.Remove(SECSY::Entity{1, 1});  // stale handle, nothing happens
+  EXPECT_FALSE(grid.Contains(small));
+  EXPECT_TRUE(Query(grid, Rectangle{0, 0, 64, 64}).empty());
+  EXPECT_EQ(grid.Size(), 2u);
+
+  grid.Clear();
+  EXPECT_EQ(grid.Size(), 0u);
+  EXPECT_TRUE(Query(grid, Rectangle{-1000, -1000, 2000, 2000}).empty());
+}
+
+TEST(Render_Culling, SubmitsOnlyWhatTheCameraSees) {
+  SECSY::Registry reg;
+  HeadlessRenderer renderer(320, 180);
+  FakeCache textures;
+  SECSY::RenderSystem system(reg, 64);
+
+  auto inside  = Spawn(reg, textures, 100, 100);
+  auto edge    = Spawn(reg, textures, 310, 170);  // partly on screen
+  auto outside = Spawn(reg, textures, 1000, 100);
+
+  renderer.Begin();
+  system.Run(renderer, textures);
+  renderer.End();
+  EXPECT_EQ(Drawn(system), (std::vector<SECSY::Entity>{inside, edge}));
+  EXPECT_EQ(renderer.Stats().sprites, 2u);
+
+  // the camera moves right and zooms in: 160x90 world units from x = 900
+  renderer.SetCamera(SECSY::RenderCamera{{900, 80}, 2.0f});
+  renderer.Begin();
+  system.Run(renderer, textures);
+  renderer.End();
+  EXPECT_EQ(Drawn(system), (std::vector<SECSY::Entity>{outside}));
+
+  // drawn in target pixels relative to the camera
+  const auto& quad = renderer.Backend().Quads().at(0);
+  EXPECT_FLOAT_EQ(quad.top_left.x, 200);
+  EXPECT_FLOAT_EQ(quad.top_left.y, 40);
+  EXPECT_FLOAT_EQ(quad.bottom_right.x, 232);
+  EXPECT_FLOAT_EQ(quad.bottom_right.y, 72);
+}
+
+TEST(Render_Culling, FollowsChangesAndDestruction) {
+  SECSY::Registry reg;
+  HeadlessRenderer renderer(320, 180);
+  FakeCache textures;
+  SECSY::RenderSystem system(reg, 64);
+
+  auto a = Spawn(reg, textures, 10, 10);
+  auto b = Spawn(reg, textures, 50, 10);
+  system.Sync();
+  EXPECT_EQ(system.Grid().Size(), 2u);
+
+  // moved off screen through a mutable reference
+  reg.Get<SECSY::Transform>(a).position.x = 5000;
+  // grown through its Transform until it covers the screen from far away
+  auto c = Spawn(reg, textures, -2000, -2000);
+  reg.Get<SECSY::Transform>(c).scale = {200, 200};
+
+  renderer.Begin();
+  system.Run(renderer, textures);
+  renderer.End();
+  EXPECT_EQ(Drawn(system), (std::vector<SECSY::Entity>{b, c}));
+
+  reg.Destroy(b);
+  reg.Remove<SECSY::Sprite>(c);
+  EXPECT_EQ(system.Grid().Size(), 1u);
+
+  renderer.Begin();
+  system.Run(renderer, textures);
+  renderer.End();
+  EXPECT_TRUE(system.Visible().empty());
+
+  // Clear fires no signals, Rebuild catches up
+  reg.Clear();
+  system.Rebuild();
+  EXPECT_EQ(system.Grid().Size(), 0u);
+}
+
+TEST(Render_Culling, StaleTexturesAreSkippedAndCounted) {
+  SECSY::Registry reg;
+  HeadlessRenderer renderer(320, 180);
+  FakeCache textures;
+  SECSY::RenderSystem system(reg, 64);
+
+  auto kept  = Spawn(reg, textures, 10, 10);
+  auto stale = Spawn(reg, textures, 50, 10);
+  auto other = textures.Load("other.png");
+  reg.Get<SECSY::Sprite>(stale).texture = other;
+  textures.Release(other);
+  EXPECT_EQ(textures.TryGet(other), nullptr);
+
+  renderer.Begin();
+  EXPECT_NO_THROW(system.Run(renderer, textures));
+  renderer.End();
+  EXPECT_EQ(Drawn(system), (std::vector<SECSY::Entity>{kept}));
+  EXPECT_EQ(system.Stale(), 1u);
+  EXPECT_EQ(renderer.Stats().sprites, 1u);
+}
+
+TEST(Render_Culling, BoundsCoverRotatedSprites) {
+  SECSY::Transform tf{{100, 100}, 90.0f, {2, 1}};
+  SECSY::Sprite sprite{SECSY::TextureHandle::Null,
+                       Rectangle{0, 0, 16, 8},
+                       Color{255, 255, 255, 255},
+                       0};
+
+  // 32x8, turned a quarter clockwise around its top-left corner
+  Rectangle bounds = SECSY::RenderSystem::Bounds(tf, sprite);
+  EXPECT_NEAR(bounds.x, 92, 1e-4);
+  EXPECT_NEAR(bounds.y, 100, 1e-4);
+  EXPECT_NEAR(bounds.width, 8, 1e-4);
+  EXPECT_NEAR(bounds.height, 32, 1e-4);
+}
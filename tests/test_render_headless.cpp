@@ -0,0 +1,127 @@
+#include <cmath>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <SECSY/Render/HeadlessBackend.hpp>
+#include <SECSY/Render/Renderer.hpp>
+
+using HeadlessRenderer = SECSY::BasicRenderer<SECSY::HeadlessBackend>;
+
+namespace {
+
+SpriteDrawCommand Sprite(unsigned int texture_, int layer_, float x_ = 0) {
+  SpriteDrawCommand cmd{};
+  cmd.texture  = Texture2D{texture_, 16, 8, 1, 0};
+  cmd.source   = {0, 0, 16, 8};
+  cmd.position = {x_, 0};
+  cmd.scale    = {1, 1};
+  cmd.tint     = {255, 255, 255, 255};
+  cmd.layer    = layer_;
+  return cmd;
+}
+
+}  // namespace
+
+TEST(Render_Headless, BatchesFollowLayerThenTexture) {
+  HeadlessRenderer renderer(320, 180);
+
+  renderer.Begin();
+  renderer.Submit(Sprite(2, 1, 0));
+  renderer.Submit(Sprite(1, 1, 1));
+  renderer.Submit(Sprite(2, 1, 2));
+  renderer.Submit(Sprite(1, -3, 3));
+  renderer.Submit(Sprite(1, 0, 4));
+  renderer.End();
+
+  const auto& backend = renderer.Backend();
+  ASSERT_EQ(backend.Batches().size(), 2u);
+  EXPECT_EQ(backend.Batches()[0].texture, 1u);  // layers -3, 0 and 1
+  EXPECT_EQ(backend.Batches()[0].count, 3u);
+  EXPECT_EQ(backend.Batches()[1].texture, 2u);
+  EXPECT_EQ(backend.Batches()[1].count, 2u);
+
+  // ties keep submission order
+  std::vector<float> xs;
+  for (const auto& quad : backend.Quads()) {
+    xs.push_back(quad.top_left.x);
+  }
+  EXPECT_EQ(xs, (std::vector<float>{3, 4, 1, 0, 2}));
+
+  EXPECT_EQ(renderer.Stats().sprites, 5u);
+  EXPECT_EQ(renderer.Stats().batches, 2u);
+  EXPECT_EQ(renderer.Stats().texture_switches, 1u);
+  EXPECT_EQ(backend.Frames(), 1u);
+}
+
+TEST(Render_Headless, QuadsMatchDrawTextureProCorners) {
+  HeadlessRenderer renderer(320, 180);
+
+  auto cmd     = Sprite(1, 0, 10);
+  cmd.scale    = {2, 1};
+  cmd.rotation = 90;
+  renderer.Begin();
+  renderer.Submit(cmd);
+  renderer.End();
+
+  // 32x8 on screen, turned a quarter clockwise around its top-left corner
+  const auto& quad = renderer.Backend().Quads().at(0);
+  EXPECT_FLOAT_EQ(quad.top_left.x, 10);
+  EXPECT_NEAR(quad.top_right.x, 10, 1e-4);
+  EXPECT_NEAR(quad.top_right.y, 32, 1e-4);
+  EXPECT_NEAR(quad.bottom_left.x, 2, 1e-4);
+  EXPECT_NEAR(quad.bottom_left.y, 0, 1e-4);
+  EXPECT_NEAR(quad.bottom_right.x, 2, 1e-4);
+  EXPECT_NEAR(quad.bottom_right.y, 32, 1e-4);
+}
+
+TEST(Render_Headless, EmptyFrameAndReuse) {
+  HeadlessRenderer renderer(320, 180);
+  renderer.Reserve(64);
+
+  renderer.Begin();
+  renderer.End();
+  EXPECT_TRUE(renderer.Backend().Batches().empty());
+  EXPECT_EQ(renderer.Stats().batches, 0u);
+
+  renderer.Begin();
+  renderer.Submit(Sprite(4, 0));
+  renderer.End();
+  EXPECT_EQ(renderer.Backend().Batches().size(), 1u);
+  EXPECT_EQ(renderer.Backend().Quads().size(), 1u);
+  EXPECT_EQ(renderer.Backend().Frames(), 2u);
+}
+
+TEST(Render_Headless, SourceRectsShareOneTexture) {
+  HeadlessRenderer renderer(320, 180);
+
+  // two regions of one 64x32 page, the second flipped horizontally
+  auto left     = Sprite(7, 0, 0);
+  left.texture  = Texture2D{7, 64, 32, 1, 0};
+  left.source   = {0, 0, 16, 16};
+  auto right    = Sprite(7, 0, 20);
+  right.texture = left.texture;
+  right.source  = {32, 16, -32, 16};
+  renderer.Begin();
+  renderer.Submit(left);
+  renderer.Submit(right);
+  renderer.End();
+
+  const auto& backend = renderer.Backend();
+  ASSERT_EQ(backend.Batches().size(), 1u);
+
+  const auto& a = backend.Quads().at(0);
+  EXPECT_FLOAT_EQ(a.bottom_right.x, 16);
+  EXPECT_FLOAT_EQ(a.bottom_right.y, 16);
+  EXPECT_FLOAT_EQ(a.uv_top_left.x, 0);
+  EXPECT_FLOAT_EQ(a.uv_top_left.y, 0);
+  EXPECT_FLOAT_EQ(a.uv_bottom_right.x, 0.25f);
+  EXPECT_FLOAT_EQ(a.uv_bottom_right.y, 0.5f);
+
+  const auto& b = backend.Quads().at(1);
+  EXPECT_FLOAT_EQ(b.bottom_right.x, 52);
+  EXPECT_FLOAT_EQ(b.uv_top_left.x, 1.0f);
+  EXPECT_FLOAT_EQ(b.uv_top_left.y, 0.5f);
+  EXPECT_FLOAT_EQ(b.uv_bottom_right.x, 0.5f);
+  EXPECT_FLOAT_EQ(b.uv_bottom_right.y, 1.0f);
+}
@@ -0,0 +1,101 @@
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <SECSY/Render/TextureCache.hpp>
+
+namespace {
+
+// hands out ids in order and records what gets unloaded into *unloaded;
+// "missing.png" fails to load
+struct FakeLoader {
+  std::vector<unsigned int>* unloaded;
+  unsigned int next{1};
+
+  Texture2D Load(const char* path_) {
+    if (std::string(path_) == "missing.png") {
+      return Texture2D{};
+    }
+    return Texture2D{next++, 32, 16, 1, 0};
+  }
+
+  void Unload(Texture2D texture_) {
+    unloaded->push_back(texture_.id);
+  }
+};
+
+using FakeCache = SECSY::BasicTextureCache<FakeLoader>;
+
+}  // namespace
+
+TEST(Render_TextureCache, LoadsEachPathOnce) {
+  std::vector<unsigned int> unloaded;
+  FakeCache cache(FakeLoader{&unloaded});
+  auto hero  = cache.Load("hero.png");
+  auto again = cache.Load("hero.png");
+  auto tiles = cache.Load("tiles.png");
+
+  EXPECT_EQ(hero, again);
+  EXPECT_NE(hero, tiles);
+  EXPECT_TRUE(hero.IsValid());
+  EXPECT_EQ(cache.Size(), 2u);
+  EXPECT_EQ(cache.RefCount(hero), 2u);
+  EXPECT_EQ(cache.Get(hero).id, 1u);
+  EXPECT_EQ(cache.Get(tiles).id, 2u);
+  EXPECT_EQ(cache.Get(tiles).width, 32);
+
+  EXPECT_THROW(cache.Load("missing.png"), std::runtime_error);
+  EXPECT_EQ(cache.Size(), 2u);
+}
+
+TEST(Render_TextureCache, LastReleaseUnloads) {
+  std::vector<unsigned int> unloaded;
+  FakeCache cache(FakeLoader{&unloaded});
+  auto hero = cache.Load("hero.png");
+  cache.Acquire(hero);
+
+  cache.Release(hero);
+  EXPECT_TRUE(cache.Contains(hero));
+  EXPECT_TRUE(unloaded.empty());
+
+  cache.Release(hero);
+  EXPECT_FALSE(cache.Contains(hero));
+  EXPECT_EQ(unloaded, (std::vector<unsigned int>{1}));
+  EXPECT_EQ(cache.Size(), 0u);
+  EXPECT_THROW(cache.Get(hero), std::out_of_range);
+  EXPECT_EQ(cache.TryGet(hero), nullptr);
+  EXPECT_THROW(cache.Acquire(hero), std::out_of_range);
+  cache.Release(hero);  // already released, nothing happens
+
+  // the slot is reused, the stale handle stays stale
+  auto tiles = cache.Load("tiles.png");
+  EXPECT_EQ(tiles.Index(), hero.Index());
+  EXPECT_NE(tiles, hero);
+  EXPECT_FALSE(cache.Contains(hero));
+  EXPECT_EQ(cache.TryGet(hero), nullptr);
+  EXPECT_EQ(cache.TryGet(tiles), &cache.Get(tiles));
+
+  // loading the path again loads it anew
+  auto reloaded = cache.Load("hero.png");
+  EXPECT_EQ(cache.Get(reloaded).id, 3u);
+}
+
+TEST(Render_TextureCache, AdoptedAndLeftoverTexturesAreUnloaded) {
+  std::vector<unsigned int> unloaded;
+  {
+    FakeCache cache(FakeLoader{&unloaded});
+    auto page = cache.Adopt(Texture2D{40, 2048, 2048, 1, 7});
+    auto hero = cache.Load("hero.png");
+    cache.Load("tiles.png");
+    EXPECT_EQ(cache.Get(page).id, 40u);
+    EXPECT_EQ(cache.Loader().next, 3u);
+
+    cache.Release(page);
+    cache.Release(hero);
+    EXPECT_EQ(unloaded, (std::vector<unsigned int>{40, 1}));
+  }
+  // tiles.png was never released
+  EXPECT_EQ(unloaded, (std::vector<unsigned int>{40, 1, 2}));
+}